@@ -0,0 +1,190 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "BenchmarkEnvironmentModel.h"
+#include <boost/units/systems/angle/degrees.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+
+using namespace omnetpp;
+
+namespace artery
+{
+
+Define_Module(BenchmarkEnvironmentModel)
+
+namespace
+{
+
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const std::size_t rank = static_cast<std::size_t>(std::ceil(p * sorted.size()));
+    return sorted[std::min(std::max<std::size_t>(rank, 1), sorted.size()) - 1];
+}
+
+double wrap(double coord, double size)
+{
+    coord = std::fmod(coord, size);
+    return coord < 0.0 ? coord + size : coord;
+}
+
+} // namespace
+
+BenchmarkEnvironmentModel::~BenchmarkEnvironmentModel()
+{
+    cancelAndDelete(mTrigger);
+}
+
+void BenchmarkEnvironmentModel::initialize()
+{
+    GlobalEnvironmentModel::initialize();
+
+    mStepLength = par("stepLength");
+    mRemainingSteps = par("numSteps");
+    mAreaSize = par("areaSize");
+    if (mStepLength <= SimTime::ZERO) {
+        throw cRuntimeError("stepLength has to be positive");
+    }
+
+    populate();
+
+    mTrigger = new cMessage("benchmark step");
+    scheduleAt(simTime() + mStepLength, mTrigger);
+}
+
+void BenchmarkEnvironmentModel::handleMessage(cMessage* msg)
+{
+    if (msg == mTrigger) {
+        step();
+        if (--mRemainingSteps > 0) {
+            scheduleAt(simTime() + mStepLength, mTrigger);
+        }
+    } else {
+        throw cRuntimeError("unexpected message");
+    }
+}
+
+void BenchmarkEnvironmentModel::finish()
+{
+    const std::size_t numDetections = mDetectionLatencies.size();
+    report("refresh", mRefreshLatencies, mKinematics.size() * mRefreshLatencies.size());
+    report("detection", mDetectionLatencies, numDetections);
+    recordScalar("detectedObjects", mDetectedObjects);
+    EV_INFO << mDetectedObjects << " objects detected by " << numDetections << " detections\n";
+
+    GlobalEnvironmentModel::finish();
+}
+
+void BenchmarkEnvironmentModel::populate()
+{
+    using boost::units::si::meters;
+    using boost::units::degree::degrees;
+
+    // building blocks of a Manhattan grid, streets are running in between
+    const int blocks = std::max(1, static_cast<int>(std::round(std::sqrt(par("numObstacles").intValue()))));
+    const double pitch = mAreaSize / blocks;
+    const double streetWidth = std::min(par("streetWidth").doubleValue(), 0.5 * pitch);
+    for (int bx = 0; bx < blocks; ++bx) {
+        for (int by = 0; by < blocks; ++by) {
+            const double x0 = bx * pitch + 0.5 * streetWidth;
+            const double y0 = by * pitch + 0.5 * streetWidth;
+            const double x1 = (bx + 1) * pitch - 0.5 * streetWidth;
+            const double y1 = (by + 1) * pitch - 0.5 * streetWidth;
+            std::vector<Position> outline { Position(x0, y0), Position(x1, y0), Position(x1, y1), Position(x0, y1) };
+            addObstacle("block_" + std::to_string(bx) + "_" + std::to_string(by), outline);
+        }
+    }
+    buildObstacleRtree();
+
+    const int numObjects = par("numObjects");
+    const double movingRatio = par("movingRatio");
+    const double distancePerStep = par("speed").doubleValue() * mStepLength.dbl();
+    mKinematics.resize(numObjects);
+    mMotions.resize(numObjects);
+    mSensors.resize(numObjects);
+
+    for (int i = 0; i < numObjects; ++i) {
+        // place objects on streets, i.e. along the grid lines between blocks
+        const bool eastbound = intrand(2) == 0;
+        const double street = intrand(blocks) * pitch;
+        const double along = uniform(0.0, mAreaSize);
+        const double distance = uniform(0.0, 1.0) < movingRatio ? distancePerStep : 0.0;
+
+        VehicleKinematics& kinematics = mKinematics[i];
+        kinematics.position = eastbound ? Position(along, street) : Position(street, along);
+        kinematics.heading = vanetza::units::Angle { (eastbound ? 90.0 : 0.0) * degrees };
+        kinematics.speed = distance / mStepLength.dbl() * boost::units::si::meters_per_second;
+        // y axis is pointing southwards
+        mMotions[i] = eastbound ? Motion { distance, 0.0 } : Motion { 0.0, -distance };
+
+        const std::string id = "object_" + std::to_string(i);
+        addObject(id, 4.5 * meters, 1.8 * meters, [this, i]() { return mKinematics[i]; });
+
+        SensorConfigRadar& sensor = mSensors[i];
+        sensor.egoID = id;
+        sensor.sensorID = i;
+        sensor.sensorPosition = SensorPosition::FRONT;
+        sensor.fieldOfView.range = par("sensorRange").doubleValue() * meters;
+        sensor.fieldOfView.angle = par("sensorAngle").doubleValue() * degrees;
+        sensor.numSegments = par("sensorSegments");
+        sensor.doLineOfSightCheck = par("doLineOfSightCheck");
+    }
+
+    // batched detections are computed by refresh, thus included in its latency
+    if (par("batchDetection")) {
+        for (const SensorConfigRadar& sensor : mSensors) {
+            registerDetection(sensor);
+        }
+    }
+}
+
+void BenchmarkEnvironmentModel::step()
+{
+    using clock = std::chrono::steady_clock;
+    using seconds = std::chrono::duration<double>;
+
+    for (std::size_t i = 0; i < mKinematics.size(); ++i) {
+        Position& position = mKinematics[i].position;
+        position.x = wrap(position.x.value() + mMotions[i].dx, mAreaSize) * boost::units::si::meters;
+        position.y = wrap(position.y.value() + mMotions[i].dy, mAreaSize) * boost::units::si::meters;
+    }
+
+    const auto refreshStart = clock::now();
+    refresh();
+    mRefreshLatencies.push_back(seconds(clock::now() - refreshStart).count());
+
+    for (const SensorConfigRadar& sensor : mSensors) {
+        const auto detectionStart = clock::now();
+        SensorDetection detection = fetchDetection(sensor);
+        mDetectionLatencies.push_back(seconds(clock::now() - detectionStart).count());
+        mDetectedObjects += detection.objects.size();
+    }
+}
+
+void BenchmarkEnvironmentModel::report(const std::string& name, std::vector<double>& latencies, std::size_t operations)
+{
+    std::sort(latencies.begin(), latencies.end());
+    const double total = std::accumulate(latencies.begin(), latencies.end(), 0.0);
+    const double throughput = total > 0.0 ? operations / total : 0.0;
+
+    recordScalar((name + " throughput").c_str(), throughput, "1/s");
+    recordScalar((name + " latency p50").c_str(), percentile(latencies, 0.5), "s");
+    recordScalar((name + " latency p90").c_str(), percentile(latencies, 0.9), "s");
+    recordScalar((name + " latency p99").c_str(), percentile(latencies, 0.99), "s");
+    recordScalar((name + " latency max").c_str(), percentile(latencies, 1.0), "s");
+
+    EV_INFO << name << " throughput " << throughput << " 1/s, latency [us]"
+        << " p50 " << percentile(latencies, 0.5) * 1e6
+        << " p90 " << percentile(latencies, 0.9) * 1e6
+        << " p99 " << percentile(latencies, 0.99) * 1e6
+        << " max " << percentile(latencies, 1.0) * 1e6 << "\n";
+}
+
+} // namespace artery
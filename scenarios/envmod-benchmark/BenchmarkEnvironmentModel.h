@@ -0,0 +1,61 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef BENCHMARKENVIRONMENTMODEL_H_K2VN7QXE
+#define BENCHMARKENVIRONMENTMODEL_H_K2VN7QXE
+
+#include "artery/application/VehicleKinematics.h"
+#include "artery/envmod/GlobalEnvironmentModel.h"
+#include "artery/envmod/sensor/SensorConfiguration.h"
+#include <omnetpp/cmessage.h>
+#include <string>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * BenchmarkEnvironmentModel measures the run-time costs of the environment model without SUMO
+ *
+ * Synthetic objects drive along the streets of a Manhattan grid whose blocks are occupied by obstacles.
+ * Each object carries a front radar. At each step, the model is refreshed and all radars detect their objects.
+ * Latencies of refreshes and detections are measured by wall-clock time and reported at finish.
+ * With batched detection enabled, the radars' detections are part of each refresh.
+ */
+class BenchmarkEnvironmentModel : public GlobalEnvironmentModel
+{
+public:
+    ~BenchmarkEnvironmentModel();
+
+    void initialize() override;
+    void handleMessage(omnetpp::cMessage*) override;
+    void finish() override;
+
+private:
+    struct Motion
+    {
+        double dx; /*< movement per step along x axis */
+        double dy; /*< movement per step along y axis */
+    };
+
+    void populate();
+    void step();
+    void report(const std::string& name, std::vector<double>& latencies, std::size_t operations);
+
+    omnetpp::cMessage* mTrigger = nullptr;
+    omnetpp::SimTime mStepLength;
+    int mRemainingSteps = 0;
+    double mAreaSize = 0.0;
+    std::vector<VehicleKinematics> mKinematics;
+    std::vector<Motion> mMotions;
+    std::vector<SensorConfigRadar> mSensors;
+    std::vector<double> mRefreshLatencies; /*< seconds */
+    std::vector<double> mDetectionLatencies; /*< seconds */
+    std::size_t mDetectedObjects = 0;
+};
+
+} // namespace artery
+
+#endif /* BENCHMARKENVIRONMENTMODEL_H_K2VN7QXE */
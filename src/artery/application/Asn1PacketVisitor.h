@@ -32,7 +32,7 @@ namespace artery
 template<class T>
 struct Asn1PacketVisitor : public boost::static_visitor<const T*>
 {
-    const T* operator()(vanetza::CohesivePacket& packet)
+    const T* operator()(const vanetza::CohesivePacket& packet)
     {
         const auto range = packet[vanetza::OsiLayer::Application];
         vanetza::ByteBuffer buffer { range.begin(), range.end() };
@@ -40,13 +40,13 @@ struct Asn1PacketVisitor : public boost::static_visitor<const T*>
         return shared_wrapper.get();
     }
 
-    const T* operator()(vanetza::ChunkPacket& packet)
+    const T* operator()(const vanetza::ChunkPacket& packet)
     {
         typedef vanetza::convertible::byte_buffer byte_buffer;
         typedef vanetza::convertible::byte_buffer_impl<T> byte_buffer_impl;
 
-        byte_buffer* ptr = packet[vanetza::OsiLayer::Application].ptr();
-        auto impl = dynamic_cast<byte_buffer_impl*>(ptr);
+        const byte_buffer* ptr = packet[vanetza::OsiLayer::Application].ptr();
+        auto impl = dynamic_cast<const byte_buffer_impl*>(ptr);
         if (impl) {
             shared_wrapper = impl->wrapper();
             return shared_wrapper.get();
@@ -7,6 +7,7 @@
 #include "artery/application/CaObject.h"
 #include "artery/application/CaService.h"
 #include "artery/application/Asn1PacketVisitor.h"
+#include "artery/application/EncodedAsn1Buffer.h"
 #include "artery/application/MultiChannelPolicy.h"
 #include "artery/application/VehicleDataProvider.h"
 #include "artery/utility/simtime_cast.h"
@@ -33,6 +34,7 @@ auto centimeter_per_second = vanetza::units::si::meter_per_second * boost::units
 static const simsignal_t scSignalCamReceived = cComponent::registerSignal("CamReceived");
 static const simsignal_t scSignalCamSent = cComponent::registerSignal("CamSent");
 static const auto scLowFrequencyContainerInterval = std::chrono::milliseconds(500);
+static const std::size_t scMaxCamTemplates = 16;
 
 template<typename T, typename U>
 long round(const boost::units::quantity<T>& q, const U& u)
@@ -55,6 +57,47 @@ SpeedValue_t buildSpeedValue(const vanetza::units::Velocity& v)
 	return speed;
 }
 
+void initLowFrequencyContainer(vanetza::asn1::Cam& message)
+{
+	LowFrequencyContainer_t*& lfc = message->cam.camParameters.lowFrequencyContainer;
+	lfc = vanetza::asn1::allocate<LowFrequencyContainer_t>();
+	lfc->present = LowFrequencyContainer_PR_basicVehicleContainerLowFrequency;
+	BasicVehicleContainerLowFrequency& bvc = lfc->choice.basicVehicleContainerLowFrequency;
+	bvc.vehicleRole = VehicleRole_default;
+	bvc.exteriorLights.buf = static_cast<uint8_t*>(vanetza::asn1::allocate(1));
+	assert(nullptr != bvc.exteriorLights.buf);
+	bvc.exteriorLights.size = 1;
+	bvc.exteriorLights.buf[0] |= 1 << (7 - ExteriorLights_daytimeRunningLightsOn);
+}
+
+void resizePathHistory(vanetza::asn1::Cam& message, unsigned pathHistoryLength)
+{
+	if (pathHistoryLength > 40) {
+		EV_WARN << "path history can contain 40 elements at maximum";
+		pathHistoryLength = 40;
+	}
+
+	LowFrequencyContainer_t* lfc = message->cam.camParameters.lowFrequencyContainer;
+	assert(lfc && lfc->present == LowFrequencyContainer_PR_basicVehicleContainerLowFrequency);
+	PathHistory_t& pathHistory = lfc->choice.basicVehicleContainerLowFrequency.pathHistory;
+
+	while (static_cast<unsigned>(pathHistory.list.count) > pathHistoryLength) {
+		PathPoint* pathPoint = pathHistory.list.array[pathHistory.list.count - 1];
+		asn_sequence_del(&pathHistory, pathHistory.list.count - 1, 0);
+		vanetza::asn1::free(asn_DEF_PathPoint, pathPoint);
+	}
+
+	while (static_cast<unsigned>(pathHistory.list.count) < pathHistoryLength) {
+		PathPoint* pathPoint = vanetza::asn1::allocate<PathPoint>();
+		pathPoint->pathDeltaTime = vanetza::asn1::allocate<PathDeltaTime_t>();
+		*(pathPoint->pathDeltaTime) = 0;
+		pathPoint->pathPosition.deltaLatitude = DeltaLatitude_unavailable;
+		pathPoint->pathPosition.deltaLongitude = DeltaLongitude_unavailable;
+		pathPoint->pathPosition.deltaAltitude = DeltaAltitude_unavailable;
+		ASN_SEQUENCE_ADD(&pathHistory, pathPoint);
+	}
+}
+
 
 Define_Module(CaService)
 
@@ -63,7 +106,9 @@ CaService::CaService() :
 		mGenCamMax { 1000, SIMTIME_MS },
 		mGenCam(mGenCamMax),
 		mGenCamLowDynamicsCounter(0),
-		mGenCamLowDynamicsLimit(3)
+		mGenCamLowDynamicsLimit(3),
+		mValidationInterval(0),
+		mGeneratedCams(0)
 {
 }
 
@@ -93,6 +138,7 @@ void CaService::initialize()
 
 	mDccRestriction = par("withDccRestriction");
 	mFixedRate = par("fixedRate");
+	mValidationInterval = par("validationInterval");
 
 	// look up primary channel for CA
 	mPrimaryChannel = getFacilities().get_const<MultiChannelPolicy>().primaryChannel(vanetza::aid::CA);
@@ -104,12 +150,28 @@ void CaService::trigger()
 	checkTriggeringConditions(simTime());
 }
 
+SimTime CaService::getNextTrigger() const
+{
+	// no CAM can be generated before minimum interval has elapsed (DCC restricts even more)
+	return mLastCamTimestamp + mGenCamMin;
+}
+
 void CaService::indicate(const vanetza::btp::DataIndication& ind, std::unique_ptr<vanetza::UpPacket> packet)
 {
 	Enter_Method("indicate");
+	receiveCam(*packet);
+}
+
+void CaService::indicateShared(const vanetza::btp::DataIndication& ind, std::shared_ptr<const vanetza::UpPacket> packet, const NetworkInterface&)
+{
+	Enter_Method("indicate");
+	receiveCam(*packet);
+}
 
+void CaService::receiveCam(const vanetza::UpPacket& packet)
+{
 	Asn1PacketVisitor<vanetza::asn1::Cam> visitor;
-	const vanetza::asn1::Cam* cam = boost::apply_visitor(visitor, *packet);
+	const vanetza::asn1::Cam* cam = boost::apply_visitor(visitor, packet);
 	if (cam && cam->validate()) {
 		CaObject obj = visitor.shared_wrapper;
 		emit(scSignalCamReceived, &obj);
@@ -160,17 +222,24 @@ bool CaService::checkSpeedDelta() const
 void CaService::sendCam(const SimTime& T_now)
 {
 	uint16_t genDeltaTimeMod = countTaiMilliseconds(mTimer->getTimeFor(mVehicleDataProvider->updated()));
-	auto cam = createCooperativeAwarenessMessage(*mVehicleDataProvider, genDeltaTimeMod);
+	const bool lowFrequency = T_now - mLastLowCamTimestamp >= artery::simtime_cast(scLowFrequencyContainerInterval);
+	std::shared_ptr<vanetza::asn1::Cam> cam = acquireCam(lowFrequency);
+	updateCooperativeAwarenessMessage(*cam, *mVehicleDataProvider, genDeltaTimeMod);
 
 	mLastCamPosition = mVehicleDataProvider->position();
 	mLastCamSpeed = mVehicleDataProvider->speed();
 	mLastCamHeading = mVehicleDataProvider->heading();
 	mLastCamTimestamp = T_now;
-	if (T_now - mLastLowCamTimestamp >= artery::simtime_cast(scLowFrequencyContainerInterval)) {
-		addLowFrequencyContainer(cam, par("pathHistoryLength"));
+	if (lowFrequency) {
+		resizePathHistory(*cam, par("pathHistoryLength"));
 		mLastLowCamTimestamp = T_now;
 	}
 
+	std::string error;
+	if (mValidationInterval > 0 && ++mGeneratedCams % mValidationInterval == 0 && !cam->validate(error)) {
+		throw cRuntimeError("Invalid CAM: %s", error.c_str());
+	}
+
 	using namespace vanetza;
 	btp::DataRequestB request;
 	request.destination_port = btp::ports::CAM;
@@ -180,16 +249,37 @@ void CaService::sendCam(const SimTime& T_now)
 	request.gn.traffic_class.tc_id(static_cast<unsigned>(dcc::Profile::DP2));
 	request.gn.communication_profile = geonet::CommunicationProfile::ITS_G5;
 
-	CaObject obj(std::move(cam));
+	CaObject obj(std::shared_ptr<const asn1::Cam> { cam });
 	emit(scSignalCamSent, &obj);
 
-	using CamByteBuffer = convertible::byte_buffer_impl<asn1::Cam>;
+	using CamByteBuffer = EncodedAsn1Buffer<asn1::Cam>;
 	std::unique_ptr<geonet::DownPacket> payload { new geonet::DownPacket() };
 	std::unique_ptr<convertible::byte_buffer> buffer { new CamByteBuffer(obj.shared_ptr()) };
 	payload->layer(OsiLayer::Application) = std::move(buffer);
 	this->request(request, std::move(payload));
 }
 
+std::shared_ptr<vanetza::asn1::Cam> CaService::acquireCam(bool lowFrequency)
+{
+	// a message can be patched in place as soon as nobody else refers to it anymore
+	auto& templates = lowFrequency ? mLowFrequencyCamTemplates : mCamTemplates;
+	for (auto& cam : templates) {
+		if (cam.use_count() == 1) {
+			return cam;
+		}
+	}
+
+	auto cam = std::make_shared<vanetza::asn1::Cam>();
+	initCooperativeAwarenessMessage(*cam, *mVehicleDataProvider);
+	if (lowFrequency) {
+		initLowFrequencyContainer(*cam);
+	}
+	if (templates.size() < scMaxCamTemplates) {
+		templates.push_back(cam);
+	}
+	return cam;
+}
+
 SimTime CaService::genCamDcc()
 {
 	// network interface may not be ready yet during initialization, so look it up at this later point
@@ -208,22 +298,31 @@ SimTime CaService::genCamDcc()
 vanetza::asn1::Cam createCooperativeAwarenessMessage(const VehicleDataProvider& vdp, uint16_t genDeltaTime)
 {
 	vanetza::asn1::Cam message;
+	initCooperativeAwarenessMessage(message, vdp);
+	updateCooperativeAwarenessMessage(message, vdp, genDeltaTime);
 
+	std::string error;
+	if (!message.validate(error)) {
+		throw cRuntimeError("Invalid High Frequency CAM: %s", error.c_str());
+	}
+
+	return message;
+}
+
+void initCooperativeAwarenessMessage(vanetza::asn1::Cam& message, const VehicleDataProvider& vdp)
+{
 	ItsPduHeader_t& header = (*message).header;
 	header.protocolVersion = 2;
 	header.messageID = ItsPduHeader__messageID_cam;
 	header.stationID = vdp.station_id();
 
 	CoopAwareness_t& cam = (*message).cam;
-	cam.generationDeltaTime = genDeltaTime * GenerationDeltaTime_oneMilliSec;
 	BasicContainer_t& basic = cam.camParameters.basicContainer;
 	HighFrequencyContainer_t& hfc = cam.camParameters.highFrequencyContainer;
 
 	basic.stationType = StationType_passengerCar;
 	basic.referencePosition.altitude.altitudeValue = AltitudeValue_unavailable;
 	basic.referencePosition.altitude.altitudeConfidence = AltitudeConfidence_unavailable;
-	basic.referencePosition.longitude = round(vdp.longitude(), microdegree) * Longitude_oneMicrodegreeEast;
-	basic.referencePosition.latitude = round(vdp.latitude(), microdegree) * Latitude_oneMicrodegreeNorth;
 	basic.referencePosition.positionConfidenceEllipse.semiMajorOrientation = HeadingValue_unavailable;
 	basic.referencePosition.positionConfidenceEllipse.semiMajorConfidence =
 			SemiAxisLength_unavailable;
@@ -232,10 +331,31 @@ vanetza::asn1::Cam createCooperativeAwarenessMessage(const VehicleDataProvider&
 
 	hfc.present = HighFrequencyContainer_PR_basicVehicleContainerHighFrequency;
 	BasicVehicleContainerHighFrequency& bvc = hfc.choice.basicVehicleContainerHighFrequency;
-	bvc.heading.headingValue = round(vdp.heading(), decidegree);
 	bvc.heading.headingConfidence = HeadingConfidence_equalOrWithinOneDegree;
-	bvc.speed.speedValue = buildSpeedValue(vdp.speed());
 	bvc.speed.speedConfidence = SpeedConfidence_equalOrWithinOneCentimeterPerSec * 3;
+	bvc.longitudinalAcceleration.longitudinalAccelerationConfidence = AccelerationConfidence_unavailable;
+	bvc.curvature.curvatureConfidence = CurvatureConfidence_unavailable;
+	bvc.curvatureCalculationMode = CurvatureCalculationMode_yawRateUsed;
+	bvc.vehicleLength.vehicleLengthValue = VehicleLengthValue_unavailable;
+	bvc.vehicleLength.vehicleLengthConfidenceIndication =
+			VehicleLengthConfidenceIndication_noTrailerPresent;
+	bvc.vehicleWidth = VehicleWidth_unavailable;
+}
+
+void updateCooperativeAwarenessMessage(vanetza::asn1::Cam& message, const VehicleDataProvider& vdp, uint16_t genDeltaTime)
+{
+	CoopAwareness_t& cam = (*message).cam;
+	cam.generationDeltaTime = genDeltaTime * GenerationDeltaTime_oneMilliSec;
+	BasicContainer_t& basic = cam.camParameters.basicContainer;
+	HighFrequencyContainer_t& hfc = cam.camParameters.highFrequencyContainer;
+
+	basic.referencePosition.longitude = round(vdp.longitude(), microdegree) * Longitude_oneMicrodegreeEast;
+	basic.referencePosition.latitude = round(vdp.latitude(), microdegree) * Latitude_oneMicrodegreeNorth;
+
+	assert(hfc.present == HighFrequencyContainer_PR_basicVehicleContainerHighFrequency);
+	BasicVehicleContainerHighFrequency& bvc = hfc.choice.basicVehicleContainerHighFrequency;
+	bvc.heading.headingValue = round(vdp.heading(), decidegree);
+	bvc.speed.speedValue = buildSpeedValue(vdp.speed());
 	bvc.driveDirection = vdp.speed().value() >= 0.0 ?
 			DriveDirection_forward : DriveDirection_backward;
 	const double lonAccelValue = vdp.acceleration() / vanetza::units::si::meter_per_second_squared;
@@ -245,56 +365,20 @@ vanetza::asn1::Cam createCooperativeAwarenessMessage(const VehicleDataProvider&
 	} else {
 		bvc.longitudinalAcceleration.longitudinalAccelerationValue = LongitudinalAccelerationValue_unavailable;
 	}
-	bvc.longitudinalAcceleration.longitudinalAccelerationConfidence = AccelerationConfidence_unavailable;
 	bvc.curvature.curvatureValue = abs(vdp.curvature() / vanetza::units::reciprocal_metre) * 10000.0;
 	if (bvc.curvature.curvatureValue >= 1023) {
 		bvc.curvature.curvatureValue = 1023;
 	}
-	bvc.curvature.curvatureConfidence = CurvatureConfidence_unavailable;
-	bvc.curvatureCalculationMode = CurvatureCalculationMode_yawRateUsed;
 	bvc.yawRate.yawRateValue = round(vdp.yaw_rate(), degree_per_second) * YawRateValue_degSec_000_01ToLeft * 100.0;
 	if (bvc.yawRate.yawRateValue < -32766 || bvc.yawRate.yawRateValue > 32766) {
 		bvc.yawRate.yawRateValue = YawRateValue_unavailable;
 	}
-	bvc.vehicleLength.vehicleLengthValue = VehicleLengthValue_unavailable;
-	bvc.vehicleLength.vehicleLengthConfidenceIndication =
-			VehicleLengthConfidenceIndication_noTrailerPresent;
-	bvc.vehicleWidth = VehicleWidth_unavailable;
-
-	std::string error;
-	if (!message.validate(error)) {
-		throw cRuntimeError("Invalid High Frequency CAM: %s", error.c_str());
-	}
-
-	return message;
 }
 
 void addLowFrequencyContainer(vanetza::asn1::Cam& message, unsigned pathHistoryLength)
 {
-	if (pathHistoryLength > 40) {
-		EV_WARN << "path history can contain 40 elements at maximum";
-		pathHistoryLength = 40;
-	}
-
-	LowFrequencyContainer_t*& lfc = message->cam.camParameters.lowFrequencyContainer;
-	lfc = vanetza::asn1::allocate<LowFrequencyContainer_t>();
-	lfc->present = LowFrequencyContainer_PR_basicVehicleContainerLowFrequency;
-	BasicVehicleContainerLowFrequency& bvc = lfc->choice.basicVehicleContainerLowFrequency;
-	bvc.vehicleRole = VehicleRole_default;
-	bvc.exteriorLights.buf = static_cast<uint8_t*>(vanetza::asn1::allocate(1));
-	assert(nullptr != bvc.exteriorLights.buf);
-	bvc.exteriorLights.size = 1;
-	bvc.exteriorLights.buf[0] |= 1 << (7 - ExteriorLights_daytimeRunningLightsOn);
-
-	for (unsigned i = 0; i < pathHistoryLength; ++i) {
-		PathPoint* pathPoint = vanetza::asn1::allocate<PathPoint>();
-		pathPoint->pathDeltaTime = vanetza::asn1::allocate<PathDeltaTime_t>();
-		*(pathPoint->pathDeltaTime) = 0;
-		pathPoint->pathPosition.deltaLatitude = DeltaLatitude_unavailable;
-		pathPoint->pathPosition.deltaLongitude = DeltaLongitude_unavailable;
-		pathPoint->pathPosition.deltaAltitude = DeltaAltitude_unavailable;
-		ASN_SEQUENCE_ADD(&bvc.pathHistory, pathPoint);
-	}
+	initLowFrequencyContainer(message);
+	resizePathHistory(message, pathHistoryLength);
 
 	std::string error;
 	if (!message.validate(error)) {
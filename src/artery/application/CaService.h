@@ -15,6 +15,8 @@
 #include <vanetza/units/angle.hpp>
 #include <vanetza/units/velocity.hpp>
 #include <omnetpp/simtime.h>
+#include <memory>
+#include <vector>
 
 namespace artery
 {
@@ -29,15 +31,19 @@ class CaService : public ItsG5BaseService
 		CaService();
 		void initialize() override;
 		void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>) override;
+		void indicateShared(const vanetza::btp::DataIndication&, std::shared_ptr<const vanetza::UpPacket>, const NetworkInterface&) override;
 		void trigger() override;
+		omnetpp::SimTime getNextTrigger() const override;
 
 	private:
+		void receiveCam(const vanetza::UpPacket&);
 		void checkTriggeringConditions(const omnetpp::SimTime&);
 		bool checkHeadingDelta() const;
 		bool checkPositionDelta() const;
 		bool checkSpeedDelta() const;
 		void sendCam(const omnetpp::SimTime&);
 		omnetpp::SimTime genCamDcc();
+		std::shared_ptr<vanetza::asn1::Cam> acquireCam(bool lowFrequency);
 
 		ChannelNumber mPrimaryChannel = channel::CCH;
 		const NetworkInterfaceTable* mNetworkInterfaceTable = nullptr;
@@ -60,11 +66,25 @@ class CaService : public ItsG5BaseService
 		vanetza::units::Velocity mSpeedDelta;
 		bool mDccRestriction;
 		bool mFixedRate;
+		unsigned mValidationInterval;
+		unsigned mGeneratedCams;
+		std::vector<std::shared_ptr<vanetza::asn1::Cam>> mCamTemplates; /*< messages without low frequency container */
+		std::vector<std::shared_ptr<vanetza::asn1::Cam>> mLowFrequencyCamTemplates;
 };
 
 vanetza::asn1::Cam createCooperativeAwarenessMessage(const VehicleDataProvider&, uint16_t genDeltaTime);
 void addLowFrequencyContainer(vanetza::asn1::Cam&, unsigned pathHistoryLength = 0);
 
+/**
+ * Fill CAM fields not changing between generations of a station, e.g. station type and vehicle dimensions
+ */
+void initCooperativeAwarenessMessage(vanetza::asn1::Cam&, const VehicleDataProvider&);
+
+/**
+ * Fill CAM fields changing with each generation, i.e. time stamp, position and vehicle dynamics
+ */
+void updateCooperativeAwarenessMessage(vanetza::asn1::Cam&, const VehicleDataProvider&, uint16_t genDeltaTime);
+
 } // namespace artery
 
 #endif /* ARTERY_CASERVICE_H_ */
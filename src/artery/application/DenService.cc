@@ -7,6 +7,7 @@
 #include "artery/application/Asn1PacketVisitor.h"
 #include "artery/application/DenmObject.h"
 #include "artery/application/DenService.h"
+#include "artery/application/EncodedAsn1Buffer.h"
 #include "artery/application/Timer.h"
 #include "artery/application/StoryboardSignal.h"
 #include "artery/application/VehicleDataProvider.h"
@@ -29,7 +30,7 @@ static const simsignal_t denmSentSignal = cComponent::registerSignal("DenmSent")
 static const simsignal_t storyboardSignal = cComponent::registerSignal("StoryboardSignal");
 
 DenService::DenService() :
-    mTimer(nullptr), mSequenceNumber(0)
+    mTimer(nullptr), mVehicleDataProvider(nullptr), mSequenceNumber(0)
 {
 }
 
@@ -37,6 +38,7 @@ void DenService::initialize()
 {
     ItsG5BaseService::initialize();
     mTimer = &getFacilities().get_const<Timer>();
+    mVehicleDataProvider = getFacilities().get_const_ptr<VehicleDataProvider>();
     mMemory.reset(new artery::den::Memory(*mTimer));
 
     subscribe(storyboardSignal);
@@ -81,10 +83,20 @@ void DenService::receiveSignal(cComponent*, simsignal_t signal, cObject* obj, cO
 }
 
 void DenService::indicate(const vanetza::btp::DataIndication& indication, std::unique_ptr<vanetza::UpPacket> packet)
+{
+    receiveDenm(*packet);
+}
+
+void DenService::indicateShared(const vanetza::btp::DataIndication& indication, std::shared_ptr<const vanetza::UpPacket> packet, const NetworkInterface&)
+{
+    receiveDenm(*packet);
+}
+
+void DenService::receiveDenm(const vanetza::UpPacket& packet)
 {
     Asn1PacketVisitor<vanetza::asn1::Denm> visitor;
-    const vanetza::asn1::Denm* denm = boost::apply_visitor(visitor, *packet);
-    const auto egoStationID = getFacilities().get_const<VehicleDataProvider>().station_id();
+    const vanetza::asn1::Denm* denm = boost::apply_visitor(visitor, packet);
+    const auto egoStationID = getVehicleDataProvider().station_id();
 
     if (denm && (*denm)->header.stationID != egoStationID) {
         DenmObject obj = visitor.shared_wrapper;
@@ -109,11 +121,20 @@ void DenService::trigger()
 ActionID_t DenService::requestActionID()
 {
     ActionID_t id;
-    id.originatingStationID = getFacilities().get_const<VehicleDataProvider>().station_id();
+    id.originatingStationID = getVehicleDataProvider().station_id();
     id.sequenceNumber = ++mSequenceNumber;
     return id;
 }
 
+const VehicleDataProvider& DenService::getVehicleDataProvider() const
+{
+    // resolved once at initialization but only required by vehicles receiving or sending DENMs
+    if (!mVehicleDataProvider) {
+        throw cRuntimeError("no valid object of type '%s' registered", typeid(VehicleDataProvider).name());
+    }
+    return *mVehicleDataProvider;
+}
+
 const Timer* DenService::getTimer() const
 {
     return mTimer;
@@ -131,7 +152,7 @@ void DenService::sendDenm(vanetza::asn1::Denm&& message, vanetza::btp::DataReque
     emit(denmSentSignal, &obj);
 
     using namespace vanetza;
-    using DenmConvertible = vanetza::convertible::byte_buffer_impl<vanetza::asn1::Denm>;
+    using DenmConvertible = EncodedAsn1Buffer<vanetza::asn1::Denm>;
     std::unique_ptr<geonet::DownPacket> payload { new geonet::DownPacket };
     std::unique_ptr<vanetza::convertible::byte_buffer> denm { new DenmConvertible { obj.shared_ptr() } };
     payload->layer(OsiLayer::Application) = vanetza::ByteBufferConvertible { std::move(denm) };
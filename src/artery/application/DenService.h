@@ -21,6 +21,7 @@ namespace artery
 {
 
 class Timer;
+class VehicleDataProvider;
 
 class DenService : public ItsG5BaseService
 {
@@ -29,6 +30,7 @@ class DenService : public ItsG5BaseService
         void initialize() override;
         void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
         void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>) override;
+        void indicateShared(const vanetza::btp::DataIndication&, std::shared_ptr<const vanetza::UpPacket>, const NetworkInterface&) override;
         void trigger() override;
 
         using ItsG5BaseService::getFacilities;
@@ -40,9 +42,12 @@ class DenService : public ItsG5BaseService
 
     private:
         void fillRequest(vanetza::btp::DataRequestB&);
+        void receiveDenm(const vanetza::UpPacket&);
         void initUseCases();
+        const VehicleDataProvider& getVehicleDataProvider() const;
 
         const Timer* mTimer;
+        const VehicleDataProvider* mVehicleDataProvider;
         uint16_t mSequenceNumber;
         std::shared_ptr<artery::den::Memory> mMemory;
         std::list<artery::den::UseCase*> mUseCases;
@@ -0,0 +1,65 @@
+#ifndef ARTERY_ENCODEDASN1BUFFER_H_QX4HD7MT
+#define ARTERY_ENCODEDASN1BUFFER_H_QX4HD7MT
+
+#include <vanetza/common/byte_buffer.hpp>
+#include <vanetza/common/byte_buffer_convertible.hpp>
+#include <memory>
+
+namespace artery
+{
+
+/**
+ * EncodedAsn1Buffer is a byte buffer convertible encoding its ASN.1 message at most once
+ *
+ * The encoded bytes are created on first demand and shared with all duplicates of this buffer.
+ * Receivers can still access the decoded message without decoding it again (see Asn1PacketVisitor).
+ * The wrapped message must not be modified once it has been handed over to a buffer.
+ */
+template<typename T>
+class EncodedAsn1Buffer : public vanetza::convertible::byte_buffer_impl<T>
+{
+public:
+    using base_type = vanetza::convertible::byte_buffer_impl<T>;
+
+    EncodedAsn1Buffer(const std::shared_ptr<const T>& message) :
+        base_type(message), mEncoding(std::make_shared<Encoding>())
+    {
+    }
+
+    void convert(vanetza::ByteBuffer& buffer) const override
+    {
+        buffer = encoded();
+    }
+
+    std::size_t size() const override
+    {
+        return encoded().size();
+    }
+
+    std::unique_ptr<vanetza::convertible::byte_buffer> duplicate() const override
+    {
+        return std::unique_ptr<vanetza::convertible::byte_buffer> { new EncodedAsn1Buffer(*this) };
+    }
+
+private:
+    struct Encoding
+    {
+        vanetza::ByteBuffer bytes;
+        bool done = false;
+    };
+
+    const vanetza::ByteBuffer& encoded() const
+    {
+        if (!mEncoding->done) {
+            mEncoding->bytes = this->wrapper()->encode();
+            mEncoding->done = true;
+        }
+        return mEncoding->bytes;
+    }
+
+    std::shared_ptr<Encoding> mEncoding; /*< shared by all duplicates */
+};
+
+} // namespace artery
+
+#endif /* ARTERY_ENCODEDASN1BUFFER_H_QX4HD7MT */
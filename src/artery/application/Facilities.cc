@@ -0,0 +1,18 @@
+#include "artery/application/Facilities.h"
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+
+namespace artery
+{
+
+std::size_t FacilitySlot::lookup(const std::type_info& type)
+{
+	// registry is defined once in core, thus shared by all libraries linking against it
+	static std::mutex mutex;
+	static std::unordered_map<std::type_index, std::size_t> slots;
+	std::lock_guard<std::mutex> lock(mutex);
+	return slots.emplace(type, slots.size()).first->second;
+}
+
+} // namespace artery
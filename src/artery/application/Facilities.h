@@ -20,15 +20,37 @@
 #define ARTERY_FACILITIES_H_
 
 #include <cassert>
+#include <cstddef>
 #include <stdexcept>
-#include <typeindex>
+#include <type_traits>
 #include <typeinfo>
-#include <unordered_map>
+#include <vector>
 #include <omnetpp/cexception.h>
 
 namespace artery
 {
 
+/**
+ * FacilitySlot assigns a unique index to each type stored in Facilities
+ *
+ * Indices are assigned by a registry keyed by type on first use and are valid program-wide,
+ * so Facilities can store objects in plain arrays instead of hash maps.
+ * Each shared library may cache its own copy of a type's index, but all copies refer to the same slot.
+ */
+class FacilitySlot
+{
+	public:
+		template<typename T>
+		static std::size_t index()
+		{
+			static const std::size_t slot = lookup(typeid(T));
+			return slot;
+		}
+
+	private:
+		static std::size_t lookup(const std::type_info&);
+};
+
 /**
  * Context class for each ITS-G5 service provided by middleware
  */
@@ -40,12 +62,8 @@ class Facilities
 		{
 			static_assert(std::is_class<T>::value, "T has to be a class type");
 			using DT = typename std::decay<T>::type;
-			DT* object = nullptr;
-			auto found = m_mutable_objects.find(std::type_index(typeid(DT)));
-			if (found != m_mutable_objects.end()) {
-				object = static_cast<DT*>(found->second);
-			}
-			return object;
+			const std::size_t slot = FacilitySlot::index<DT>();
+			return slot < m_mutable_objects.size() ? static_cast<DT*>(m_mutable_objects[slot]) : nullptr;
 		}
 
 		template<typename T>
@@ -73,12 +91,8 @@ class Facilities
 		{
 			static_assert(std::is_class<T>::value, "T has to be a class type");
 			using DT = typename std::decay<T>::type;
-			const DT* object = nullptr;
-			auto found = m_const_objects.find(std::type_index(typeid(DT)));
-			if (found != m_const_objects.end()) {
-				object = static_cast<const DT*>(found->second);
-			}
-			return object;
+			const std::size_t slot = FacilitySlot::index<DT>();
+			return slot < m_const_objects.size() ? static_cast<const DT*>(m_const_objects[slot]) : nullptr;
 		}
 
 		template<typename T>
@@ -107,7 +121,11 @@ class Facilities
 			assert(object);
 			static_assert(std::is_class<T>::value, "T has to be a class type");
 			using DT = typename std::decay<T>::type;
-			m_mutable_objects[std::type_index(typeid(DT))] = object;
+			const std::size_t slot = FacilitySlot::index<DT>();
+			if (slot >= m_mutable_objects.size()) {
+				m_mutable_objects.resize(slot + 1, nullptr);
+			}
+			m_mutable_objects[slot] = object;
 			register_const(object);
 		}
 
@@ -123,7 +141,11 @@ class Facilities
 			assert(object);
 			static_assert(std::is_class<T>::value, "T has to be a class type");
 			using DT = typename std::decay<T>::type;
-			m_const_objects[std::type_index(typeid(DT))] = object;
+			const std::size_t slot = FacilitySlot::index<DT>();
+			if (slot >= m_const_objects.size()) {
+				m_const_objects.resize(slot + 1, nullptr);
+			}
+			m_const_objects[slot] = object;
 		}
 
 		template<typename T>
@@ -133,8 +155,8 @@ class Facilities
 		}
 
 	private:
-		std::unordered_map<std::type_index, void*> m_mutable_objects;
-		std::unordered_map<std::type_index, const void*> m_const_objects;
+		std::vector<void*> m_mutable_objects; /*< indexed by FacilitySlot */
+		std::vector<const void*> m_const_objects; /*< indexed by FacilitySlot */
 };
 
 } // namespace artery
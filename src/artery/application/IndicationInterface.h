@@ -2,6 +2,8 @@
 #define ARTERY_INDICATIONINTERFACE_H_
 
 #include <vanetza/btp/data_indication.hpp>
+#include <vanetza/geonet/packet.hpp>
+#include <memory>
 
 namespace artery
 {
@@ -16,6 +18,25 @@ class IndicationInterface
     public:
         virtual void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>, const NetworkInterface&) = 0;
 
+        /**
+         * Indicate a packet shared read-only among several listeners of the same port
+         *
+         * Listeners merely inspecting packets should override this method to avoid packet copies.
+         * By default, the packet is copied for the ordinary indicate method unless no other listener refers to it.
+         */
+        virtual void indicateShared(const vanetza::btp::DataIndication& ind, std::shared_ptr<const vanetza::UpPacket> packet, const NetworkInterface& net)
+        {
+            std::unique_ptr<vanetza::UpPacket> own;
+            if (packet.use_count() == 1) {
+                // last reference: dispatcher created the shared packet from a mutable one, thus moving is safe
+                own.reset(new vanetza::UpPacket { std::move(const_cast<vanetza::UpPacket&>(*packet)) });
+            } else {
+                own.reset(new vanetza::UpPacket { *packet });
+            }
+            packet.reset();
+            indicate(ind, std::move(own), net);
+        }
+
         virtual ~IndicationInterface() = default;
 };
 
@@ -106,6 +106,18 @@ void ItsG5BaseService::trigger()
 {
 }
 
+omnetpp::SimTime ItsG5BaseService::getNextTrigger() const
+{
+	// trigger by every update
+	return omnetpp::SimTime::ZERO;
+}
+
+void ItsG5BaseService::scheduleTrigger(omnetpp::SimTime due)
+{
+	assert(m_middleware);
+	m_middleware->scheduleTrigger(this, due);
+}
+
 void ItsG5BaseService::request(const vanetza::btp::DataRequestB& req,
 	std::unique_ptr<vanetza::DownPacket> packet, const NetworkInterface* interface)
 {
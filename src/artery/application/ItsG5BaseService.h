@@ -60,6 +60,17 @@ class ItsG5BaseService :
 		 */
 		virtual void trigger();
 
+		/**
+		 * Determine when this service requires its next trigger.
+		 *
+		 * Middleware asks for this time after each trigger and skips triggers of this service until then.
+		 * A service is triggered by the first middleware update at or after the returned time.
+		 * Services not overriding this method are triggered by every update.
+		 *
+		 * \return earliest time of next trigger, SimTime::getMaxTime() if only triggered on demand
+		 */
+		virtual omnetpp::SimTime getNextTrigger() const;
+
 		/**
 		 * Add listening transport descriptor (channel + BTP port).
 		 *
@@ -79,6 +90,7 @@ class ItsG5BaseService :
 		void initialize() override;
 		void finish() override;
 		void request(const vanetza::btp::DataRequestB&, std::unique_ptr<vanetza::DownPacket>, const NetworkInterface* = nullptr);
+		void scheduleTrigger(omnetpp::SimTime due);
 		void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>, const NetworkInterface&) override;
 		virtual void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>);
 		Facilities& getFacilities();
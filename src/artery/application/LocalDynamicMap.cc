@@ -1,12 +1,77 @@
 #include "artery/application/LocalDynamicMap.h"
 #include "artery/application/Timer.h"
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/ring.hpp>
+#include <boost/math/constants/constants.hpp>
 #include <omnetpp/csimulation.h>
 #include <cassert>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace artery
 {
 
+namespace
+{
+
+using boost::math::double_constants::degree;
+using boost::math::double_constants::two_pi;
+
+const double cellSize = 0.001; // degree, i.e. about 111 m along meridians
+const double earthRadius = 6371008.8; // mean earth radius in meter
+
+bool decodePosition(const ReferencePosition_t& ref, GeoPosition& pos)
+{
+    if (ref.latitude == Latitude_unavailable || ref.longitude == Longitude_unavailable) {
+        return false;
+    }
+
+    const auto microdegree = 1e-6 * boost::units::degree::degrees;
+    pos.latitude = static_cast<double>(ref.latitude) / Latitude_oneMicrodegreeNorth * microdegree;
+    pos.longitude = static_cast<double>(ref.longitude) / Longitude_oneMicrodegreeEast * microdegree;
+    return true;
+}
+
+/**
+ * Equirectangular projection around an origin, x axis points east and y axis north (meter)
+ */
+class LocalPlane
+{
+public:
+    LocalPlane(double latitude, double longitude) :
+        mLatitude(latitude), mLongitude(longitude),
+        mScaleX(earthRadius * degree * std::cos(latitude * degree)), mScaleY(earthRadius * degree)
+    {
+    }
+
+    double x(double longitude) const
+    {
+        double delta = longitude - mLongitude;
+        if (delta > 180.0) {
+            delta -= 360.0;
+        } else if (delta < -180.0) {
+            delta += 360.0;
+        }
+        return delta * mScaleX;
+    }
+
+    double y(double latitude) const { return (latitude - mLatitude) * mScaleY; }
+
+    double latitudeSpan(double distance) const { return distance / mScaleY; }
+    double longitudeSpan(double distance) const { return mScaleX > 0.0 ? distance / mScaleX : 360.0; }
+
+private:
+    double mLatitude;
+    double mLongitude;
+    double mScaleX;
+    double mScaleY;
+};
+
+} // namespace
+
 LocalDynamicMap::LocalDynamicMap(const Timer& timer) :
     mTimer(timer)
 {
@@ -28,26 +93,50 @@ void LocalDynamicMap::updateAwareness(const CaObject& obj)
     }
 
     AwarenessEntry entry(obj, expiry);
+    entry.located = decodePosition(msg->cam.camParameters.basicContainer.referencePosition, entry.position);
+
     auto found = mCaMessages.find(msg->header.stationID);
     if (found != mCaMessages.end()) {
+        unindex(found->first, found->second);
+        entry.row = found->second.row;
         found->second = std::move(entry);
     } else {
-        mCaMessages.emplace(msg->header.stationID, std::move(entry));
+        entry.row = mColumns.size();
+        mColumns.station.push_back(msg->header.stationID);
+        mColumns.latitude.emplace_back();
+        mColumns.longitude.emplace_back();
+        mColumns.speed.emplace_back();
+        mColumns.heading.emplace_back();
+        mColumns.stationType.emplace_back();
+        found = mCaMessages.emplace(msg->header.stationID, std::move(entry)).first;
     }
+    index(found->first, found->second);
+    writeRow(found->second.row, msg);
+    mExpiries.push(ExpiryItem { expiry, found->first });
 }
 
 void LocalDynamicMap::dropExpired()
 {
     const auto now = omnetpp::simTime();
-    for (auto it = mCaMessages.begin(); it != mCaMessages.end();) {
-        if (it->second.expiry < now) {
-            it = mCaMessages.erase(it);
-        } else {
-            ++it;
+    while (!mExpiries.empty() && mExpiries.top().expiry < now) {
+        const ExpiryItem item = mExpiries.top();
+        mExpiries.pop();
+
+        // entry might have been refreshed by a more recent CAM meanwhile
+        auto found = mCaMessages.find(item.station);
+        if (found != mCaMessages.end() && found->second.expiry == item.expiry) {
+            unindex(found->first, found->second);
+            removeRow(found->second.row);
+            mCaMessages.erase(found);
         }
     }
 }
 
+omnetpp::SimTime LocalDynamicMap::getNextExpiry() const
+{
+    return mExpiries.empty() ? omnetpp::SimTime::getMaxTime() : mExpiries.top().expiry;
+}
+
 unsigned LocalDynamicMap::count(const CamPredicate& predicate) const
 {
     return std::count_if(mCaMessages.begin(), mCaMessages.end(),
@@ -57,8 +146,226 @@ unsigned LocalDynamicMap::count(const CamPredicate& predicate) const
             });
 }
 
+const LocalDynamicMap::Cam* LocalDynamicMap::getCam(StationID station) const
+{
+    auto found = mCaMessages.find(station);
+    return found != mCaMessages.end() ? &found->second.object.asn1() : nullptr;
+}
+
+std::vector<LocalDynamicMap::StationPosition>
+LocalDynamicMap::stationsWithinRadius(const GeoPosition& centre, vanetza::units::Length radius) const
+{
+    const double lat = centre.latitude / boost::units::degree::degrees;
+    const double lon = centre.longitude / boost::units::degree::degrees;
+    const double range = radius / boost::units::si::meters;
+    const LocalPlane plane(lat, lon);
+
+    std::vector<StationPosition> stations;
+    const double latSpan = plane.latitudeSpan(range);
+    const double lonSpan = plane.longitudeSpan(range);
+    visitCells(lat - latSpan, lat + latSpan, lon - lonSpan, lon + lonSpan, [&](const CellItem& item) {
+            const double distance = std::hypot(plane.x(item.longitude), plane.y(item.latitude));
+            if (distance <= range) {
+                stations.push_back(resolve(item, distance));
+            }
+        });
+    return stations;
+}
+
+std::vector<LocalDynamicMap::StationPosition>
+LocalDynamicMap::stationsWithinSector(const GeoPosition& centre, vanetza::units::Length radius,
+        vanetza::units::Angle direction, vanetza::units::Angle opening) const
+{
+    const double lat = centre.latitude / boost::units::degree::degrees;
+    const double lon = centre.longitude / boost::units::degree::degrees;
+    const double range = radius / boost::units::si::meters;
+    const double bisector = direction / boost::units::si::radians;
+    const double halfOpening = 0.5 * opening / boost::units::si::radians;
+    const LocalPlane plane(lat, lon);
+
+    std::vector<StationPosition> stations;
+    const double latSpan = plane.latitudeSpan(range);
+    const double lonSpan = plane.longitudeSpan(range);
+    visitCells(lat - latSpan, lat + latSpan, lon - lonSpan, lon + lonSpan, [&](const CellItem& item) {
+            const double x = plane.x(item.longitude);
+            const double y = plane.y(item.latitude);
+            const double distance = std::hypot(x, y);
+            if (distance > range) {
+                return;
+            } else if (distance > 0.0) {
+                // bearing is measured clockwise from north
+                const double delta = std::remainder(std::atan2(x, y) - bisector, two_pi);
+                if (std::abs(delta) > halfOpening) {
+                    return;
+                }
+            }
+            stations.push_back(resolve(item, distance));
+        });
+    return stations;
+}
+
+std::vector<LocalDynamicMap::StationPosition>
+LocalDynamicMap::stationsWithinPolygon(const std::vector<GeoPosition>& polygon) const
+{
+    namespace bg = boost::geometry;
+    using Point = bg::model::d2::point_xy<double>;
+
+    std::vector<StationPosition> stations;
+    if (polygon.size() < 3) {
+        return stations;
+    }
+
+    const double lat = polygon.front().latitude / boost::units::degree::degrees;
+    const double lon = polygon.front().longitude / boost::units::degree::degrees;
+    const LocalPlane plane(lat, lon);
+
+    bg::model::ring<Point> ring;
+    double minLat = lat, maxLat = lat, minLon = lon, maxLon = lon;
+    for (const GeoPosition& vertex : polygon) {
+        const double vertexLat = vertex.latitude / boost::units::degree::degrees;
+        const double vertexLon = vertex.longitude / boost::units::degree::degrees;
+        minLat = std::min(minLat, vertexLat);
+        maxLat = std::max(maxLat, vertexLat);
+        minLon = std::min(minLon, vertexLon);
+        maxLon = std::max(maxLon, vertexLon);
+        ring.push_back(Point { plane.x(vertexLon), plane.y(vertexLat) });
+    }
+    bg::correct(ring);
+
+    visitCells(minLat, maxLat, minLon, maxLon, [&](const CellItem& item) {
+            const Point point { plane.x(item.longitude), plane.y(item.latitude) };
+            if (bg::covered_by(point, ring)) {
+                stations.push_back(resolve(item, std::hypot(point.x(), point.y())));
+            }
+        });
+    return stations;
+}
+
+void LocalDynamicMap::visitCells(double minLat, double maxLat, double minLon, double maxLon, const Visitor& visitor) const
+{
+    const double minX = std::floor(minLon / cellSize);
+    const double maxX = std::floor(maxLon / cellSize);
+    const double minY = std::floor(minLat / cellSize);
+    const double maxY = std::floor(maxLat / cellSize);
+    const double numCells = (maxX - minX + 1.0) * (maxY - minY + 1.0);
+
+    if (minLon < -180.0 || maxLon > 180.0 || numCells > mCells.size()) {
+        // visiting all occupied cells is cheaper (or query wraps around antimeridian)
+        for (const auto& cell : mCells) {
+            std::for_each(cell.second.begin(), cell.second.end(), visitor);
+        }
+        return;
+    }
+
+    for (double x = minX; x <= maxX; ++x) {
+        for (double y = minY; y <= maxY; ++y) {
+            const CellKey key = (static_cast<CellKey>(static_cast<std::uint32_t>(static_cast<std::int32_t>(y))) << 32) |
+                static_cast<std::uint32_t>(static_cast<std::int32_t>(x));
+            auto found = mCells.find(key);
+            if (found != mCells.end()) {
+                std::for_each(found->second.begin(), found->second.end(), visitor);
+            }
+        }
+    }
+}
+
+void LocalDynamicMap::index(StationID station, const AwarenessEntry& entry)
+{
+    if (entry.located) {
+        const double lat = entry.position.latitude / boost::units::degree::degrees;
+        const double lon = entry.position.longitude / boost::units::degree::degrees;
+        mCells[getCellKey(lat, lon)].push_back(CellItem { station, lat, lon });
+    }
+}
+
+void LocalDynamicMap::unindex(StationID station, const AwarenessEntry& entry)
+{
+    if (entry.located) {
+        const double lat = entry.position.latitude / boost::units::degree::degrees;
+        const double lon = entry.position.longitude / boost::units::degree::degrees;
+        auto found = mCells.find(getCellKey(lat, lon));
+        if (found != mCells.end()) {
+            Cell& cell = found->second;
+            auto it = std::find_if(cell.begin(), cell.end(), [station](const CellItem& item) { return item.station == station; });
+            if (it != cell.end()) {
+                // order within a cell is irrelevant: swap with last item and pop it
+                *it = cell.back();
+                cell.pop_back();
+            }
+            if (cell.empty()) {
+                mCells.erase(found);
+            }
+        }
+    }
+}
+
+LocalDynamicMap::StationPosition LocalDynamicMap::resolve(const CellItem& item, double distance) const
+{
+    const AwarenessEntry& entry = mCaMessages.at(item.station);
+    return StationPosition { item.station, entry.position, distance * boost::units::si::meters, &entry.object.asn1(), entry.row };
+}
+
+void LocalDynamicMap::writeRow(std::size_t row, const Cam& msg)
+{
+    static const double nan = std::numeric_limits<double>::quiet_NaN();
+    const auto& bc = msg->cam.camParameters.basicContainer;
+    const auto& hfc = msg->cam.camParameters.highFrequencyContainer;
+
+    if (bc.referencePosition.latitude != Latitude_unavailable && bc.referencePosition.longitude != Longitude_unavailable) {
+        mColumns.latitude[row] = static_cast<double>(bc.referencePosition.latitude) / Latitude_oneMicrodegreeNorth * 1e-6;
+        mColumns.longitude[row] = static_cast<double>(bc.referencePosition.longitude) / Longitude_oneMicrodegreeEast * 1e-6;
+    } else {
+        mColumns.latitude[row] = nan;
+        mColumns.longitude[row] = nan;
+    }
+
+    mColumns.speed[row] = nan;
+    mColumns.heading[row] = nan;
+    if (hfc.present == HighFrequencyContainer_PR_basicVehicleContainerHighFrequency) {
+        const auto& bvc = hfc.choice.basicVehicleContainerHighFrequency;
+        if (bvc.speed.speedValue != SpeedValue_unavailable) {
+            mColumns.speed[row] = static_cast<float>(bvc.speed.speedValue) / (100.0f * SpeedValue_oneCentimeterPerSec);
+        }
+        if (bvc.heading.headingValue != HeadingValue_unavailable) {
+            mColumns.heading[row] = static_cast<float>(bvc.heading.headingValue) / 10.0f;
+        }
+    }
+
+    mColumns.station[row] = msg->header.stationID;
+    mColumns.stationType[row] = bc.stationType;
+}
+
+void LocalDynamicMap::removeRow(std::size_t row)
+{
+    const std::size_t last = mColumns.size() - 1;
+    if (row != last) {
+        // fill gap with last row
+        mColumns.station[row] = mColumns.station[last];
+        mColumns.latitude[row] = mColumns.latitude[last];
+        mColumns.longitude[row] = mColumns.longitude[last];
+        mColumns.speed[row] = mColumns.speed[last];
+        mColumns.heading[row] = mColumns.heading[last];
+        mColumns.stationType[row] = mColumns.stationType[last];
+        mCaMessages.at(mColumns.station[row]).row = row;
+    }
+
+    mColumns.station.pop_back();
+    mColumns.latitude.pop_back();
+    mColumns.longitude.pop_back();
+    mColumns.speed.pop_back();
+    mColumns.heading.pop_back();
+    mColumns.stationType.pop_back();
+}
+
+LocalDynamicMap::CellKey LocalDynamicMap::getCellKey(double latitude, double longitude) const
+{
+    const auto y = static_cast<std::int32_t>(std::floor(latitude / cellSize));
+    const auto x = static_cast<std::int32_t>(std::floor(longitude / cellSize));
+    return (static_cast<CellKey>(static_cast<std::uint32_t>(y)) << 32) | static_cast<std::uint32_t>(x);
+}
+
 LocalDynamicMap::AwarenessEntry::AwarenessEntry(const CaObject& obj, omnetpp::SimTime t) :
-    expiry(t), object(obj)
+    expiry(t), object(obj), located(false), row(0)
 {
 }
 
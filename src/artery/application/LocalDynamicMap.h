@@ -2,11 +2,18 @@
 #define ARTERY_LOCALDYNAMICMAP_H_AL7SS9KT
 
 #include "artery/application/CaObject.h"
+#include "artery/utility/Geometry.h"
 #include <omnetpp/simtime.h>
 #include <vanetza/asn1/cam.hpp>
+#include <vanetza/units/angle.hpp>
+#include <vanetza/units/length.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <map>
+#include <queue>
+#include <unordered_map>
+#include <vector>
 
 namespace artery
 {
@@ -20,12 +27,91 @@ public:
     using Cam = vanetza::asn1::Cam;
     using CamPredicate = std::function<bool(const Cam&)>;
 
+    /**
+     * Hot CAM fields decoded once on reception and stored column by column
+     *
+     * All columns have equal length and row i of each column belongs to the same station.
+     * Rows are reordered when stations are dropped, i.e. row indices are only valid until the map is modified.
+     */
+    struct CamColumns
+    {
+        std::vector<StationID> station;
+        std::vector<double> latitude; /*< degree, NaN if unavailable */
+        std::vector<double> longitude; /*< degree, NaN if unavailable */
+        std::vector<float> speed; /*< m/s, NaN if unavailable */
+        std::vector<float> heading; /*< degree clockwise from north, NaN if unavailable */
+        std::vector<StationType_t> stationType;
+
+        std::size_t size() const { return station.size(); }
+    };
+
+    /**
+     * Station found by a spatial query
+     */
+    struct StationPosition
+    {
+        StationID station;
+        GeoPosition position; /*< decoded reference position of CAM */
+        vanetza::units::Length distance; /*< distance to query centre */
+        const Cam* cam; /*< full message, valid until map is modified */
+        std::size_t row; /*< row in columns(), valid until map is modified */
+    };
+
     LocalDynamicMap(const Timer&);
     void updateAwareness(const CaObject&);
     void dropExpired();
+
+    /**
+     * Get expiry time of the earliest expiring entry (may be outdated by refreshed entries)
+     * @return expiry time, SimTime::getMaxTime() if map is empty
+     */
+    omnetpp::SimTime getNextExpiry() const;
     unsigned count(const CamPredicate&) const;
 
+    /**
+     * Get decoded CAM fields of all stations in map
+     * @return columns of hot CAM fields
+     */
+    const CamColumns& columns() const { return mColumns; }
+
+    /**
+     * Get full CAM of a station
+     * @param station station identifier
+     * @return message or nullptr if station is unknown
+     */
+    const Cam* getCam(StationID station) const;
+
+    /**
+     * Find stations within a circle
+     *
+     * Distances are approximated on a local tangent plane, i.e. queries are meant for a few kilometres at most.
+     * @param centre circle centre
+     * @param radius circle radius
+     * @return stations in no particular order
+     */
+    std::vector<StationPosition> stationsWithinRadius(const GeoPosition& centre, vanetza::units::Length radius) const;
+
+    /**
+     * Find stations within a circular sector
+     * @param centre apex of sector
+     * @param radius sector radius
+     * @param direction bisector of sector (clockwise from north like CAM headings)
+     * @param opening opening angle of sector
+     * @return stations in no particular order
+     */
+    std::vector<StationPosition> stationsWithinSector(const GeoPosition& centre, vanetza::units::Length radius,
+            vanetza::units::Angle direction, vanetza::units::Angle opening) const;
+
+    /**
+     * Find stations within a polygon
+     * @param polygon vertices of polygon (open or closed ring)
+     * @return stations in no particular order, distances refer to first vertex
+     */
+    std::vector<StationPosition> stationsWithinPolygon(const std::vector<GeoPosition>& polygon) const;
+
 private:
+    using CellKey = std::uint64_t;
+
     struct AwarenessEntry
     {
         AwarenessEntry(const CaObject&, omnetpp::SimTime);
@@ -34,13 +120,45 @@ private:
 
         omnetpp::SimTime expiry;
         CaObject object;
+        GeoPosition position;
+        bool located; /*< false if CAM lacks reference position */
+        std::size_t row; /*< row in CamColumns */
+    };
+
+    struct CellItem
+    {
+        StationID station;
+        double latitude; /*< degree */
+        double longitude; /*< degree */
+    };
+
+    struct ExpiryItem
+    {
+        omnetpp::SimTime expiry;
+        StationID station;
+
+        bool operator>(const ExpiryItem& other) const { return expiry > other.expiry; }
     };
 
+    using ExpiryQueue = std::priority_queue<ExpiryItem, std::vector<ExpiryItem>, std::greater<ExpiryItem>>;
+    using Cell = std::vector<CellItem>;
+    using Visitor = std::function<void(const CellItem&)>;
+
+    void visitCells(double minLatitude, double maxLatitude, double minLongitude, double maxLongitude, const Visitor&) const;
+    void index(StationID, const AwarenessEntry&);
+    void unindex(StationID, const AwarenessEntry&);
+    StationPosition resolve(const CellItem&, double distance) const;
+    void writeRow(std::size_t row, const Cam&);
+    void removeRow(std::size_t row);
+    CellKey getCellKey(double latitude, double longitude) const;
+
     const Timer& mTimer;
     std::map<StationID, AwarenessEntry> mCaMessages;
+    ExpiryQueue mExpiries; /*< earliest expiry on top, may contain outdated items of refreshed entries */
+    std::unordered_map<CellKey, Cell> mCells; /*< stations binned by their reference position */
+    CamColumns mColumns;
 };
 
 } // namespace artery
 
 #endif /* ARTERY_LOCALDYNAMICMAP_H_AL7SS9KT */
-
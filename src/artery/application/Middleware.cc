@@ -7,6 +7,7 @@
 #include "artery/application/Middleware.h"
 #include "artery/application/ItsG5PromiscuousService.h"
 #include "artery/application/ItsG5Service.h"
+#include "artery/application/MiddlewareTicker.h"
 #include "artery/application/XmlMultiChannelPolicy.h"
 #include "artery/networking/PositionProvider.h"
 #include "artery/networking/Router.h"
@@ -16,6 +17,9 @@
 #include "artery/utility/InitStages.h"
 #include "artery/utility/FilterRules.h"
 #include "inet/common/ModuleAccess.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
 
 using namespace omnetpp;
 
@@ -52,6 +56,10 @@ Middleware::Middleware() : mLocalDynamicMap(mTimer)
 
 Middleware::~Middleware()
 {
+    // nodes torn down without finish must not stay subscribed
+    if (mTicker) {
+        mTicker->unsubscribe(this);
+    }
     cancelAndDelete(mUpdateMessage);
 }
 
@@ -65,7 +73,11 @@ void Middleware::initialize(int stage)
     if (stage == InitStages::Prepare) {
         mTimer.setTimebase(par("datetime"));
         mUpdateInterval = par("updateInterval");
-        mUpdateMessage = new cMessage("middleware update");
+        if (!par("tickerModule").stdstringValue().empty()) {
+            mTicker = inet::getModuleFromPar<MiddlewareTicker>(par("tickerModule"), this);
+        } else {
+            mUpdateMessage = new cMessage("middleware update");
+        }
         mIdentity.host = findHost();
         mIdentity.host->subscribe(Identity::changeSignal, this);
         mMultiChannelPolicy.reset(new XmlMultiChannelPolicy(par("mcoPolicy").xmlValue()));
@@ -82,7 +94,16 @@ void Middleware::initialize(int stage)
 
         // start update cycle with random jitter to avoid unrealistic node synchronization
         const auto jitter = uniform(SimTime(0, SIMTIME_MS), mUpdateInterval);
-        scheduleAt(simTime() + jitter + mUpdateInterval, mUpdateMessage);
+        mUpdatePhase = simTime() + jitter + mUpdateInterval;
+        mLastUpdate = mUpdatePhase - mUpdateInterval;
+        if (mTicker) {
+            if (mTicker->getUpdateInterval() != mUpdateInterval) {
+                error("update interval differs from interval of middleware ticker");
+            }
+            mTicker->subscribe(this, mUpdatePhase);
+        } else {
+            scheduleUpdate();
+        }
     } else if (stage == InitStages::Propagate) {
         emit(artery::IdentityRegistry::updateSignal, &mIdentity);
     }
@@ -141,6 +162,8 @@ void Middleware::initializeServices(int stage)
                 }
 
                 mServices.emplace(service);
+                mTriggerSchedules.emplace(service, TriggerSchedule { static_cast<unsigned>(mTriggerSchedules.size()), SimTime::getMaxTime() });
+                pushTrigger(service, SimTime::ZERO);
             } else {
                 error("%s is not of type ItsG5BaseService", module_type->getFullName());
             }
@@ -155,6 +178,10 @@ void Middleware::initializeServices(int stage)
 
 void Middleware::finish()
 {
+    if (mTicker) {
+        mTicker->unsubscribe(this);
+        mTicker = nullptr;
+    }
     emit(artery::IdentityRegistry::removeSignal, &mIdentity);
 }
 
@@ -162,6 +189,7 @@ void Middleware::handleMessage(cMessage *msg)
 {
     if (msg == mUpdateMessage) {
         updateServices();
+        scheduleUpdate();
     } else {
         error("Middleware cannot handle message '%s'", msg->getFullName());
     }
@@ -192,13 +220,87 @@ void Middleware::registerNetworkInterface(std::shared_ptr<NetworkInterface> ifc)
     mNetworkInterfaceTable.insert(ifc);
 }
 
+void Middleware::tick()
+{
+    Enter_Method_Silent();
+    updateServices();
+}
+
 void Middleware::updateServices()
 {
+    const SimTime now = simTime();
+    mLastUpdate = now;
     mLocalDynamicMap.dropExpired();
-    for (auto& service : mServices) {
-        service->trigger();
+
+    mDueTriggers.clear();
+    while (!mTriggers.empty() && mTriggers.top().due <= now) {
+        const TriggerItem item = mTriggers.top();
+        mTriggers.pop();
+
+        // skip outdated items, service has been rescheduled meanwhile
+        TriggerSchedule& schedule = mTriggerSchedules.at(item.service);
+        if (schedule.due == item.due) {
+            schedule.due = SimTime::getMaxTime();
+            mDueTriggers.push_back(item);
+        }
+    }
+
+    std::sort(mDueTriggers.begin(), mDueTriggers.end(),
+            [](const TriggerItem& a, const TriggerItem& b) { return a.order < b.order; });
+    for (const TriggerItem& item : mDueTriggers) {
+        item.service->trigger();
+        pushTrigger(item.service, item.service->getNextTrigger());
     }
-    scheduleAt(simTime() + mUpdateInterval, mUpdateMessage);
+}
+
+void Middleware::scheduleTrigger(ItsG5BaseService* service, SimTime due)
+{
+    Enter_Method_Silent();
+    pushTrigger(service, due);
+    // self-scheduled update cycle might need to wake up earlier (unless it has not been started yet)
+    if (!mTicker && mUpdatePhase != SimTime::ZERO) {
+        scheduleUpdate();
+    }
+}
+
+void Middleware::pushTrigger(ItsG5BaseService* service, SimTime due)
+{
+    auto found = mTriggerSchedules.find(service);
+    if (found == mTriggerSchedules.end()) {
+        error("cannot schedule trigger of unknown service");
+    } else if (due < found->second.due) {
+        found->second.due = due;
+        mTriggers.push(TriggerItem { due, found->second.order, service });
+    }
+}
+
+void Middleware::scheduleUpdate()
+{
+    // skip updates while no service is due (outdated items cause spurious updates at worst)
+    SimTime next = mLocalDynamicMap.getNextExpiry();
+    if (!mTriggers.empty()) {
+        next = std::min(next, mTriggers.top().due);
+    }
+
+    if (next != SimTime::getMaxTime()) {
+        const SimTime update = getUpdateTime(next);
+        if (!mUpdateMessage->isScheduled()) {
+            scheduleAt(update, mUpdateMessage);
+        } else if (update < mUpdateMessage->getArrivalTime()) {
+            cancelEvent(mUpdateMessage);
+            scheduleAt(update, mUpdateMessage);
+        }
+    }
+}
+
+SimTime Middleware::getUpdateTime(SimTime t) const
+{
+    // updates take place at multiples of update interval after the first update
+    const SimTime earliest = std::max(t, mLastUpdate + mUpdateInterval);
+    const std::int64_t interval = mUpdateInterval.raw();
+    const std::int64_t offset = (earliest - mUpdatePhase).raw();
+    const std::int64_t cycles = (offset + interval - 1) / interval;
+    return mUpdatePhase + SimTime::fromRaw(cycles * interval);
 }
 
 void Middleware::requestTransmission(const vanetza::btp::DataRequestB& request,
@@ -217,23 +319,30 @@ void Middleware::requestTransmission(const vanetza::btp::DataRequestB& request,
         EV_WARN << "No channel found for ITS-AID " << request.gn.its_aid << "\n";
     }
 
-    unsigned pass = 0;
+    std::vector<std::shared_ptr<NetworkInterface>> interfaces;
+    interfaces.reserve(channels.size());
     for (ChannelNumber channel : channels) {
         auto netifc = mNetworkInterfaceTable.select(channel);
         if (netifc) {
-            ++pass;
-            if (channels.size() > pass) {
-                // duplicate packet for all but last network interface
-                netifc->getRouter().request(request, vanetza::duplicate(*packet));
-            } else {
-                // last network interface -> pass "original" packet
-                netifc->getRouter().request(request, std::move(packet));
-            }
+            interfaces.push_back(std::move(netifc));
         } else {
             EV_ERROR << "No network interface operating on channel " <<  channel << "\n";
         }
     }
 
+    // duplicates share the payload with the original packet if its convertibles support this,
+    // e.g. EncodedAsn1Buffer and SharedByteBuffer, i.e. the payload is neither copied nor encoded again
+    const unsigned pass = interfaces.size();
+    for (unsigned i = 0; i < pass; ++i) {
+        if (i + 1 < pass) {
+            // duplicate packet for all but last network interface
+            interfaces[i]->getRouter().request(request, vanetza::duplicate(*packet));
+        } else {
+            // last network interface -> pass "original" packet
+            interfaces[i]->getRouter().request(request, std::move(packet));
+        }
+    }
+
     if (pass == 0) {
         EV_ERROR << "ITS-AID " << request.gn.its_aid << " packet lost in Middleware\n";
     } else {
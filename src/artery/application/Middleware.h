@@ -21,14 +21,19 @@
 #include <omnetpp/simtime.h>
 #include <vanetza/btp/data_request.hpp>
 #include <vanetza/btp/port_dispatcher.hpp>
+#include <functional>
 #include <memory>
+#include <queue>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace artery
 {
 
 // forward declarations
 class ItsG5BaseService;
+class MiddlewareTicker;
 class Router;
 
 /**
@@ -58,6 +63,17 @@ class Middleware : public omnetpp::cSimpleModule, public omnetpp::cListener
         void requestTransmission(const vanetza::btp::DataRequestB&, std::unique_ptr<vanetza::DownPacket>);
         void requestTransmission(const vanetza::btp::DataRequestB&, std::unique_ptr<vanetza::DownPacket>, const NetworkInterface&);
 
+        /**
+         * Schedule trigger of a service
+         *
+         * Service will be triggered by the first update at or after the given time.
+         * An earlier scheduled trigger of this service is kept.
+         *
+         * \param service service to trigger
+         * \param due earliest trigger time
+         */
+        void scheduleTrigger(ItsG5BaseService* service, omnetpp::SimTime due);
+
     protected:
         // cSimpleModule
         int numInitStages() const override;
@@ -72,11 +88,40 @@ class Middleware : public omnetpp::cSimpleModule, public omnetpp::cListener
         void setStationType(const StationType&);
 
     private:
+        friend class MiddlewareTicker;
+
+        struct TriggerItem
+        {
+            omnetpp::SimTime due;
+            unsigned order; /*< services due at the same time are triggered in order of their creation */
+            ItsG5BaseService* service;
+
+            bool operator>(const TriggerItem& other) const
+            {
+                return due > other.due || (due == other.due && order > other.order);
+            }
+        };
+
+        struct TriggerSchedule
+        {
+            unsigned order;
+            omnetpp::SimTime due;
+        };
+
+        using TriggerQueue = std::priority_queue<TriggerItem, std::vector<TriggerItem>, std::greater<TriggerItem>>;
+
+        void tick();
         void updateServices();
         void initializeServices(int stage);
+        void pushTrigger(ItsG5BaseService*, omnetpp::SimTime due);
+        void scheduleUpdate();
+        omnetpp::SimTime getUpdateTime(omnetpp::SimTime) const;
 
         omnetpp::SimTime mUpdateInterval;
+        omnetpp::SimTime mUpdatePhase; /*< time of first update */
+        omnetpp::SimTime mLastUpdate;
         omnetpp::cMessage* mUpdateMessage = nullptr;
+        MiddlewareTicker* mTicker = nullptr;
         Timer mTimer;
         Identity mIdentity;
         LocalDynamicMap mLocalDynamicMap;
@@ -87,6 +132,9 @@ class Middleware : public omnetpp::cSimpleModule, public omnetpp::cListener
         TransportDispatcher mTransportDispatcher;
         std::unique_ptr<MultiChannelPolicy> mMultiChannelPolicy;
         std::set<ItsG5BaseService*> mServices;
+        std::unordered_map<ItsG5BaseService*, TriggerSchedule> mTriggerSchedules;
+        TriggerQueue mTriggers; /*< earliest trigger on top, may contain outdated items of rescheduled services */
+        std::vector<TriggerItem> mDueTriggers;
 };
 
 } // namespace artery
@@ -0,0 +1,141 @@
+/*
+* Artery V2X Simulation Framework
+* Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+*/
+
+#include "artery/application/Middleware.h"
+#include "artery/application/MiddlewareTicker.h"
+#include <algorithm>
+
+using namespace omnetpp;
+
+namespace artery
+{
+
+Define_Module(MiddlewareTicker)
+
+MiddlewareTicker::~MiddlewareTicker()
+{
+    // remaining subscribers shall not unsubscribe from a deleted ticker
+    for (auto& subscriber : mSubscribers) {
+        subscriber.first->mTicker = nullptr;
+    }
+    cancelAndDelete(mTickMessage);
+}
+
+void MiddlewareTicker::initialize()
+{
+    mUpdateInterval = par("updateInterval");
+    const int numSlots = par("numSlots");
+    if (mUpdateInterval <= SimTime::ZERO) {
+        error("update interval has to be positive");
+    } else if (numSlots < 1) {
+        error("at least one slot is required");
+    }
+
+    mSlotLength = mUpdateInterval.raw() / numSlots;
+    if (mSlotLength == 0) {
+        error("slots are shorter than simulation time resolution");
+    }
+    mSlots.resize(numSlots);
+    mTickMessage = new cMessage("middleware tick");
+}
+
+void MiddlewareTicker::handleMessage(cMessage* msg)
+{
+    if (msg == mTickMessage) {
+        const SimTime now = simTime();
+        // ticks may (un)subscribe middlewares, thus iterate over a copy of the slot
+        mTicking = mSlots[getSlot(now)];
+        for (const Subscription& subscription : mTicking) {
+            if (subscription.start <= now && mSubscribers.count(subscription.middleware)) {
+                subscription.middleware->tick();
+            }
+        }
+        mTicking.clear();
+        scheduleNextTick();
+    } else {
+        error("MiddlewareTicker cannot handle message '%s'", msg->getFullName());
+    }
+}
+
+void MiddlewareTicker::subscribe(Middleware* middleware, SimTime start)
+{
+    Enter_Method_Silent();
+    if (mSubscribers.find(middleware) != mSubscribers.end()) {
+        error("middleware %s is already subscribed", middleware->getFullPath().c_str());
+    }
+
+    // first update happens at the beginning of the slot containing the given start time
+    const std::size_t slot = getSlot(start);
+    const std::int64_t cycle = start.raw() - start.raw() % mUpdateInterval.raw();
+    const SimTime slotStart = SimTime::fromRaw(cycle + slot * mSlotLength);
+    mSlots[slot].push_back(Subscription { middleware, slotStart });
+    mSubscribers.emplace(middleware, slot);
+
+    // never postpone a pending tick, it might be due for other subscribers
+    const SimTime tick = getNextSlotTime(slot, simTime());
+    if (!mTickMessage->isScheduled()) {
+        scheduleAt(tick, mTickMessage);
+    } else if (tick < mTickMessage->getArrivalTime()) {
+        cancelEvent(mTickMessage);
+        scheduleAt(tick, mTickMessage);
+    }
+}
+
+void MiddlewareTicker::unsubscribe(Middleware* middleware)
+{
+    Enter_Method_Silent();
+    auto found = mSubscribers.find(middleware);
+    if (found != mSubscribers.end()) {
+        auto& subscriptions = mSlots[found->second];
+        auto it = std::find_if(subscriptions.begin(), subscriptions.end(),
+                [middleware](const Subscription& s) { return s.middleware == middleware; });
+        if (it != subscriptions.end()) {
+            subscriptions.erase(it);
+        }
+        mSubscribers.erase(found);
+    }
+
+    if (mSubscribers.empty()) {
+        cancelEvent(mTickMessage);
+    }
+}
+
+std::size_t MiddlewareTicker::getSlot(SimTime t) const
+{
+    const std::int64_t phase = t.raw() % mUpdateInterval.raw();
+    return std::min<std::size_t>(phase / mSlotLength, mSlots.size() - 1);
+}
+
+SimTime MiddlewareTicker::getNextSlotTime(std::size_t slot, SimTime after) const
+{
+    const std::int64_t cycle = after.raw() - after.raw() % mUpdateInterval.raw();
+    std::int64_t next = cycle + slot * mSlotLength;
+    if (next <= after.raw()) {
+        next += mUpdateInterval.raw();
+    }
+    return SimTime::fromRaw(next);
+}
+
+void MiddlewareTicker::scheduleNextTick()
+{
+    const SimTime now = simTime();
+    const std::size_t current = getSlot(now);
+    for (std::size_t i = 1; i <= mSlots.size(); ++i) {
+        const std::size_t slot = (current + i) % mSlots.size();
+        if (!mSlots[slot].empty()) {
+            // subscriptions during the current tick might have scheduled the next tick already
+            const SimTime tick = getNextSlotTime(slot, now);
+            if (!mTickMessage->isScheduled()) {
+                scheduleAt(tick, mTickMessage);
+            } else if (tick < mTickMessage->getArrivalTime()) {
+                cancelEvent(mTickMessage);
+                scheduleAt(tick, mTickMessage);
+            }
+            break;
+        }
+    }
+}
+
+} // namespace artery
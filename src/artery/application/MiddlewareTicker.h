@@ -0,0 +1,73 @@
+/*
+* Artery V2X Simulation Framework
+* Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+*/
+
+#ifndef ARTERY_MIDDLEWARETICKER_H_T5VKZ2QH
+#define ARTERY_MIDDLEWARETICKER_H_T5VKZ2QH
+
+#include <omnetpp/csimplemodule.h>
+#include <omnetpp/simtime.h>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace artery
+{
+
+class Middleware;
+
+/**
+ * MiddlewareTicker triggers the update cycles of all subscribed middlewares
+ *
+ * The update interval is divided into slots forming a timing wheel.
+ * Each middleware is placed in the slot matching its individual start-up jitter,
+ * so nodes stay desynchronised while the FES holds a single ticker event per occupied slot.
+ */
+class MiddlewareTicker : public omnetpp::cSimpleModule
+{
+public:
+    ~MiddlewareTicker();
+
+    /**
+     * Subscribe middleware to update cycle
+     * \param middleware subscriber
+     * \param start time of first update (its phase selects the slot)
+     */
+    void subscribe(Middleware* middleware, omnetpp::SimTime start);
+
+    /**
+     * Unsubscribe middleware, e.g. when its node is removed
+     * \param middleware subscriber
+     */
+    void unsubscribe(Middleware* middleware);
+
+    omnetpp::SimTime getUpdateInterval() const { return mUpdateInterval; }
+
+protected:
+    void initialize() override;
+    void handleMessage(omnetpp::cMessage*) override;
+
+private:
+    struct Subscription
+    {
+        Middleware* middleware;
+        omnetpp::SimTime start;
+    };
+
+    std::size_t getSlot(omnetpp::SimTime) const;
+    omnetpp::SimTime getNextSlotTime(std::size_t slot, omnetpp::SimTime after) const;
+    void scheduleNextTick();
+
+    omnetpp::SimTime mUpdateInterval;
+    std::int64_t mSlotLength = 0; /*< raw simulation time */
+    std::vector<std::vector<Subscription>> mSlots;
+    std::unordered_map<Middleware*, std::size_t> mSubscribers; /*< slot of each subscriber */
+    std::vector<Subscription> mTicking; /*< subscriptions of the current tick */
+    omnetpp::cMessage* mTickMessage = nullptr;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_MIDDLEWARETICKER_H_T5VKZ2QH */
@@ -61,6 +61,12 @@ void PeriodicLoadService::trigger()
     }
 }
 
+omnetpp::SimTime PeriodicLoadService::getNextTrigger() const
+{
+    // generation is self-scheduled once started
+    return mTrigger->isScheduled() ? omnetpp::SimTime::getMaxTime() : omnetpp::SimTime::ZERO;
+}
+
 void PeriodicLoadService::scheduleTransmission()
 {
     scheduleAt(simTime() + par("generationInterval"), mTrigger);
@@ -21,6 +21,7 @@ class PeriodicLoadService : public ItsG5Service
 
         void indicate(const vanetza::btp::DataIndication&, omnetpp::cPacket*, const NetworkInterface&) override;
         void trigger() override;
+        omnetpp::SimTime getNextTrigger() const override;
 
     protected:
         void initialize() override;
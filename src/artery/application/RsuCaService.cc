@@ -8,6 +8,7 @@
 #include "artery/application/LocalDynamicMap.h"
 #include "artery/application/RsuCaService.h"
 #include "artery/application/Asn1PacketVisitor.h"
+#include "artery/application/EncodedAsn1Buffer.h"
 #include "artery/application/MultiChannelPolicy.h"
 #include "artery/utility/Geometry.h"
 #include "artery/utility/Identity.h"
@@ -89,12 +90,27 @@ void RsuCaService::trigger()
     }
 }
 
+omnetpp::SimTime RsuCaService::getNextTrigger() const
+{
+    return mLastCamTimestamp + mGenerationInterval;
+}
+
 void RsuCaService::indicate(const vanetza::btp::DataIndication& ind, std::unique_ptr<vanetza::UpPacket> packet)
 {
     Enter_Method("indicate");
+    receiveCam(*packet);
+}
 
+void RsuCaService::indicateShared(const vanetza::btp::DataIndication& ind, std::shared_ptr<const vanetza::UpPacket> packet, const NetworkInterface&)
+{
+    Enter_Method("indicate");
+    receiveCam(*packet);
+}
+
+void RsuCaService::receiveCam(const vanetza::UpPacket& packet)
+{
     Asn1PacketVisitor<vanetza::asn1::Cam> visitor;
-    const vanetza::asn1::Cam* cam = boost::apply_visitor(visitor, *packet);
+    const vanetza::asn1::Cam* cam = boost::apply_visitor(visitor, packet);
     if (cam && cam->validate()) {
         CaObject obj = visitor.shared_wrapper;
         emit(scSignalCamReceived, &obj);
@@ -116,7 +132,7 @@ void RsuCaService::sendCam()
     CaObject obj(createMessage());
     emit(scSignalCamSent, &obj);
 
-    using CamByteBuffer = convertible::byte_buffer_impl<asn1::Cam>;
+    using CamByteBuffer = EncodedAsn1Buffer<asn1::Cam>;
     std::unique_ptr<geonet::DownPacket> payload { new geonet::DownPacket() };
     std::unique_ptr<convertible::byte_buffer> buffer { new CamByteBuffer(obj.shared_ptr()) };
     payload->layer(OsiLayer::Application) = std::move(buffer);
@@ -28,7 +28,9 @@ class RsuCaService : public ItsG5BaseService
     public:
         void initialize() override;
         void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>) override;
+        void indicateShared(const vanetza::btp::DataIndication&, std::shared_ptr<const vanetza::UpPacket>, const NetworkInterface&) override;
         void trigger() override;
+        omnetpp::SimTime getNextTrigger() const override;
 
         struct ProtectedCommunicationZone
         {
@@ -42,6 +44,7 @@ class RsuCaService : public ItsG5BaseService
         static std::list<ProtectedCommunicationZone> parseProtectedCommunicationZones(omnetpp::cXMLElement*);
 
     private:
+        void receiveCam(const vanetza::UpPacket&);
         void sendCam();
         vanetza::asn1::Cam createMessage() const;
 
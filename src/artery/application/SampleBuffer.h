@@ -51,6 +51,7 @@ public:
     std::size_t size() const { return m_buffer.size(); }
     bool empty() const { return m_buffer.empty(); }
     bool full() const { return m_buffer.full(); }
+    std::size_t capacity() const { return m_buffer.capacity(); }
     iterator begin() const { return iterator(m_buffer.begin()); }
     iterator end() const { return iterator(m_buffer.end()); }
 
@@ -4,6 +4,7 @@
 #include "artery/application/SampleBuffer.h"
 #include <omnetpp/simtime.h>
 #include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 template<typename IN, typename OUT = IN>
@@ -78,11 +79,12 @@ class StrictSampler : public IntervalSampler<T>
 public:
     using base_type = IntervalSampler<T>;
 
-    void feed(const typename base_type::input_type& sample, omnetpp::SimTime timestamp)
+    bool feed(const typename base_type::input_type& sample, omnetpp::SimTime timestamp)
     {
         auto offset = base_type::offset(timestamp);
         if (offset == omnetpp::SimTime::ZERO) {
             base_type::m_buffer.insert(sample, timestamp);
+            return true;
         } else if (offset < omnetpp::SimTime::ZERO) {
             throw base_type::oversampling_error();
         } else {
@@ -97,12 +99,18 @@ class SkipEarlySampler : public IntervalSampler<T>
 public:
     using base_type = IntervalSampler<T>;
 
-    void feed(const typename base_type::input_type& sample, omnetpp::SimTime timestamp)
+    /**
+     * Feed sample unless it is too early
+     * \return true if sample has been stored
+     */
+    bool feed(const typename base_type::input_type& sample, omnetpp::SimTime timestamp)
     {
         auto offset = base_type::offset(timestamp);
         if (offset >= omnetpp::SimTime::ZERO) {
             base_type::m_buffer.insert(sample, timestamp);
+            return true;
         }
+        return false;
     }
 };
 
@@ -0,0 +1,53 @@
+#ifndef ARTERY_SHAREDBYTEBUFFER_H_W3NR8FKA
+#define ARTERY_SHAREDBYTEBUFFER_H_W3NR8FKA
+
+#include <vanetza/common/byte_buffer.hpp>
+#include <vanetza/common/byte_buffer_convertible.hpp>
+#include <memory>
+
+namespace artery
+{
+
+/**
+ * SharedByteBuffer is a byte buffer convertible referring to immutable bytes
+ *
+ * Duplicates of this buffer share the bytes instead of copying them,
+ * e.g. when a packet is transmitted on several channels.
+ */
+class SharedByteBuffer : public vanetza::convertible::byte_buffer
+{
+public:
+    explicit SharedByteBuffer(vanetza::ByteBuffer&& bytes) :
+        mBytes(std::make_shared<const vanetza::ByteBuffer>(std::move(bytes)))
+    {
+    }
+
+    explicit SharedByteBuffer(const std::shared_ptr<const vanetza::ByteBuffer>& bytes) :
+        mBytes(bytes)
+    {
+    }
+
+    void convert(vanetza::ByteBuffer& buffer) const override
+    {
+        buffer = *mBytes;
+    }
+
+    std::size_t size() const override
+    {
+        return mBytes->size();
+    }
+
+    std::unique_ptr<vanetza::convertible::byte_buffer> duplicate() const override
+    {
+        return std::unique_ptr<vanetza::convertible::byte_buffer> { new SharedByteBuffer(mBytes) };
+    }
+
+    const std::shared_ptr<const vanetza::ByteBuffer>& bytes() const { return mBytes; }
+
+private:
+    std::shared_ptr<const vanetza::ByteBuffer> mBytes;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_SHAREDBYTEBUFFER_H_W3NR8FKA */
@@ -0,0 +1,181 @@
+#ifndef ARTERY_SLIDINGWINDOW_H_W7GQ3NKX
+#define ARTERY_SLIDINGWINDOW_H_W7GQ3NKX
+
+#include "artery/application/SampleBuffer.h"
+#include <omnetpp/simtime.h>
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+
+/**
+ * SlidingWindow keeps running aggregates of the samples within a window
+ *
+ * The window is bounded by its length (time span up to a reference time) and its capacity (number of samples).
+ * Sum and time integral are updated incrementally, minimum and maximum are tracked by monotonic deques.
+ * Thus, inserting samples takes amortised O(1) time and all queries take O(1) time.
+ */
+template<typename T>
+class SlidingWindow
+{
+public:
+    using value_type = T;
+    using sample_type = Sample<T>;
+
+    SlidingWindow() :
+        m_length(omnetpp::SimTime::getMaxTime()),
+        m_capacity(std::numeric_limits<std::size_t>::max()),
+        m_sum(), m_integral()
+    {
+    }
+
+    void setLength(omnetpp::SimTime length)
+    {
+        m_length = std::max(length, omnetpp::SimTime::ZERO);
+    }
+
+    omnetpp::SimTime getLength() const { return m_length; }
+
+    void setCapacity(std::size_t capacity)
+    {
+        m_capacity = capacity;
+        while (m_samples.size() > m_capacity) {
+            pop();
+        }
+    }
+
+    std::size_t getCapacity() const { return m_capacity; }
+
+    void insert(const T& value, omnetpp::SimTime timestamp)
+    {
+        if (!m_samples.empty() && m_samples.back().timestamp >= timestamp) {
+            throw std::logic_error("chronological order of samples violated");
+        } else if (m_capacity == 0) {
+            return;
+        }
+
+        if (!m_samples.empty()) {
+            const sample_type& latest = m_samples.back();
+            m_integral += latest.value * (timestamp - latest.timestamp).dbl();
+        }
+        m_samples.emplace_back(value, timestamp);
+        m_sum += value;
+
+        while (!m_minimum.empty() && !(m_minimum.back().value < value)) {
+            m_minimum.pop_back();
+        }
+        m_minimum.emplace_back(value, timestamp);
+        while (!m_maximum.empty() && !(value < m_maximum.back().value)) {
+            m_maximum.pop_back();
+        }
+        m_maximum.emplace_back(value, timestamp);
+
+        if (m_samples.size() > m_capacity) {
+            pop();
+        }
+        expire(timestamp);
+    }
+
+    /**
+     * Drop samples not younger than window length relative to given time
+     */
+    void expire(omnetpp::SimTime now)
+    {
+        if (m_length != omnetpp::SimTime::getMaxTime()) {
+            const omnetpp::SimTime limit = now - m_length;
+            while (!m_samples.empty() && m_samples.front().timestamp <= limit) {
+                pop();
+            }
+        }
+    }
+
+    void clear()
+    {
+        m_samples.clear();
+        m_minimum.clear();
+        m_maximum.clear();
+        m_sum = T();
+        m_integral = T();
+    }
+
+    std::size_t size() const { return m_samples.size(); }
+    bool empty() const { return m_samples.empty(); }
+    bool full() const { return m_samples.size() == m_capacity; }
+
+    const sample_type& latest() const { assert(!empty()); return m_samples.back(); }
+    const sample_type& oldest() const { assert(!empty()); return m_samples.front(); }
+
+    omnetpp::SimTime duration() const
+    {
+        auto d = omnetpp::SimTime::ZERO;
+        if (m_samples.size() >= 2) {
+            d = m_samples.back().timestamp - m_samples.front().timestamp;
+        }
+        return d;
+    }
+
+    T sum() const { return m_sum; }
+
+    /**
+     * Arithmetic mean of samples, default value if window is empty
+     */
+    T mean() const
+    {
+        T avg = T();
+        if (!m_samples.empty()) {
+            avg = m_sum / static_cast<double>(m_samples.size());
+        }
+        return avg;
+    }
+
+    /**
+     * Mean of samples weighted by the time until their successor (sample and hold)
+     */
+    T timeWeightedMean() const
+    {
+        const omnetpp::SimTime d = duration();
+        if (d > omnetpp::SimTime::ZERO) {
+            return m_integral / d.dbl();
+        } else {
+            return mean();
+        }
+    }
+
+    const T& min() const { assert(!empty()); return m_minimum.front().value; }
+    const T& max() const { assert(!empty()); return m_maximum.front().value; }
+
+private:
+    void pop()
+    {
+        const sample_type& oldest = m_samples.front();
+        m_sum -= oldest.value;
+        if (m_samples.size() >= 2) {
+            const sample_type& next = m_samples[1];
+            m_integral -= oldest.value * (next.timestamp - oldest.timestamp).dbl();
+        }
+        if (m_minimum.front().timestamp == oldest.timestamp) {
+            m_minimum.pop_front();
+        }
+        if (m_maximum.front().timestamp == oldest.timestamp) {
+            m_maximum.pop_front();
+        }
+        m_samples.pop_front();
+
+        if (m_samples.empty()) {
+            // reset running aggregates to avoid accumulating rounding errors
+            m_sum = T();
+            m_integral = T();
+        }
+    }
+
+    omnetpp::SimTime m_length;
+    std::size_t m_capacity;
+    std::deque<sample_type> m_samples;
+    std::deque<sample_type> m_minimum;
+    std::deque<sample_type> m_maximum;
+    T m_sum;
+    T m_integral;
+};
+
+#endif /* ARTERY_SLIDINGWINDOW_H_W7GQ3NKX */
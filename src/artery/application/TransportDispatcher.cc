@@ -28,15 +28,20 @@ void TransportDispatcher::indicate(const geonet::DataIndication& gn_ind, std::un
         // indicate regular listeners
         auto found_descriptor = mListeners.find(std::make_tuple(net.channel, btp_ind.destination_port.host()));
         if (found_descriptor != mListeners.end()) {
-            unsigned pending = found_descriptor->second.size();
-            for (IndicationInterface* listener : found_descriptor->second) {
-                if (pending > 1) {
-                    std::unique_ptr<vanetza::UpPacket> dup { new vanetza::UpPacket { *packet } };
-                    listener->indicate(btp_ind, std::move(dup), net);
-                } else {
-                    listener->indicate(btp_ind, std::move(packet), net);
+            const auto& listeners = found_descriptor->second;
+            if (listeners.size() == 1) {
+                (*listeners.begin())->indicate(btp_ind, std::move(packet), net);
+            } else {
+                // listeners share a read-only packet, those needing a private copy create it on demand
+                std::shared_ptr<const UpPacket> shared { std::move(packet) };
+                unsigned pending = listeners.size();
+                for (IndicationInterface* listener : listeners) {
+                    if (--pending > 0) {
+                        listener->indicateShared(btp_ind, shared, net);
+                    } else {
+                        listener->indicateShared(btp_ind, std::move(shared), net);
+                    }
                 }
-                --pending;
             }
         }
     } else {
@@ -19,11 +19,10 @@
 #ifndef ARTERY_VEHICLEDATAPROVIDER_H_
 #define ARTERY_VEHICLEDATAPROVIDER_H_
 
+#include "artery/application/VehicleDataStore.h"
 #include "artery/application/VehicleKinematics.h"
 #include "artery/utility/Geometry.h"
 #include <omnetpp/simtime.h>
-#include <boost/circular_buffer.hpp>
-#include <boost/units/systems/si/angular_acceleration.hpp>
 #include <vanetza/geonet/station_type.hpp>
 #include <vanetza/units/acceleration.hpp>
 #include <vanetza/units/angle.hpp>
@@ -31,34 +30,49 @@
 #include <vanetza/units/angular_velocity.hpp>
 #include <vanetza/units/curvature.hpp>
 #include <cstdint>
-#include <map>
+#include <memory>
 
 namespace artery
 {
 
+/**
+ * VehicleDataProvider grants access to the data of a single vehicle
+ *
+ * Data is kept in a slot of a VehicleDataStore: each provider owns a private store by default.
+ * Providers attached to a shared store only stage their updates, i.e. derived data such as
+ * curvature is calculated when the owner of the shared store flushes it.
+ */
 class VehicleDataProvider
 {
 	public:
 		using StationType = vanetza::geonet::StationType;
 
 		VehicleDataProvider(uint32_t id);
+		~VehicleDataProvider();
 
 		// prevent inadvertent VDP copies
 		VehicleDataProvider(const VehicleDataProvider&) = delete;
 		VehicleDataProvider& operator=(const VehicleDataProvider&) = delete;
 
+		/**
+		 * Move into a store shared with other providers
+		 *
+		 * This is only possible before the first update.
+		 */
+		void attach(std::shared_ptr<VehicleDataStore>);
+
 		void update(const VehicleKinematics&);
-		omnetpp::SimTime updated() const { return mLastUpdate; }
+		omnetpp::SimTime updated() const { return mStore->updated(mSlot); }
 
-		const Position& position() const { return mVehicleKinematics.position; }
-		vanetza::units::GeoAngle longitude() const { return mVehicleKinematics.geo_position.longitude; } // positive for east
-		vanetza::units::GeoAngle latitude() const { return mVehicleKinematics.geo_position.latitude; } // positive for north
-		vanetza::units::Velocity speed() const { return mVehicleKinematics.speed; }
-		vanetza::units::Acceleration acceleration() const { return mVehicleKinematics.acceleration; }
-		vanetza::units::Angle heading() const { return mVehicleKinematics.heading; } // degree from north, clockwise
-		vanetza::units::AngularVelocity yaw_rate() const { return mVehicleKinematics.yaw_rate; } // left turn positive
-		vanetza::units::Curvature curvature() const { return mCurvature; } // 1/m radius, left turn positive
-		double curvature_confidence() const { return mConfidence; } // percentage value
+		const Position& position() const { return mStore->position(mSlot); }
+		vanetza::units::GeoAngle longitude() const { return mStore->geo_position(mSlot).longitude; } // positive for east
+		vanetza::units::GeoAngle latitude() const { return mStore->geo_position(mSlot).latitude; } // positive for north
+		vanetza::units::Velocity speed() const { return vanetza::units::Velocity::from_value(mStore->speed(mSlot)); }
+		vanetza::units::Acceleration acceleration() const { return vanetza::units::Acceleration::from_value(mStore->acceleration(mSlot)); }
+		vanetza::units::Angle heading() const { return vanetza::units::Angle::from_value(mStore->heading(mSlot)); } // degree from north, clockwise
+		vanetza::units::AngularVelocity yaw_rate() const { return vanetza::units::AngularVelocity::from_value(mStore->yaw_rate(mSlot)); } // left turn positive
+		vanetza::units::Curvature curvature() const { return vanetza::units::Curvature::from_value(mStore->curvature(mSlot)); } // 1/m radius, left turn positive
+		double curvature_confidence() const { return mStore->curvature_confidence(mSlot); } // percentage value
 
 		void setStationType(StationType);
 		StationType getStationType() const;
@@ -68,21 +82,11 @@ class VehicleDataProvider
 		uint32_t station_id() const { return mStationId; } /*< deprecated, use getStationId */
 
 	private:
-		typedef boost::units::quantity<boost::units::si::angular_acceleration> AngularAcceleration;
-		void calculateCurvature();
-		void calculateCurvatureConfidence();
-		double mapOntoConfidence(AngularAcceleration) const;
-
 		uint32_t mStationId;
 		StationType mStationType;
-		VehicleKinematics mVehicleKinematics;
-		vanetza::units::Curvature mCurvature;
-		double mConfidence;
-		omnetpp::SimTime mLastUpdate;
-		boost::circular_buffer<vanetza::units::Curvature> mCurvatureOutput;
-		boost::circular_buffer<AngularAcceleration> mCurvatureConfidenceOutput;
-		vanetza::units::AngularVelocity mCurvatureConfidenceInput;
-		static const std::map<AngularAcceleration, double> mConfidenceTable;
+		std::shared_ptr<VehicleDataStore> mStore;
+		VehicleDataStore::Slot mSlot;
+		bool mShared;
 };
 
 } // namespace artery
@@ -0,0 +1,211 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/application/VehicleDataStore.h"
+#include <boost/math/constants/constants.hpp>
+#include <omnetpp/csimulation.h>
+#include <cmath>
+#include <limits>
+
+namespace artery
+{
+
+namespace
+{
+
+const double pi = boost::math::constants::pi<double>();
+
+// second order low-pass filter of curvature (sampled at 10 Hz, cut-off at 0.33 Hz)
+const double curvature_omega_t = 2.0 * pi * 0.33 * 0.1;
+const double curvature_b = 2.0 + 2.0 * curvature_omega_t;
+const double curvature_c = curvature_omega_t * curvature_omega_t;
+const double curvature_norm = 1.0 + 2.0 * curvature_omega_t + curvature_c;
+const double curvature_lower_threshold = 1.0 / 2500.0; // 1/m
+const double curvature_upper_threshold = 1.0; // 1/m
+
+// filter of yaw rate changes feeding curvature confidence (cut-off at 1 Hz, t_sample = 100 s)
+const double confidence_omega = 2.0 * pi * 1.0;
+const double confidence_t_sample = 100.0;
+const double confidence_b = 2.0 + 2.0 * confidence_omega * confidence_t_sample;
+const double confidence_c = confidence_omega * confidence_omega * confidence_t_sample;
+const double confidence_norm = 1.0 + 2.0 * confidence_omega * confidence_t_sample + confidence_c * confidence_t_sample;
+
+// upper bounds of angular acceleration (degree/s²) mapped onto confidence values
+const double degree = pi / 180.0;
+const double confidence_thresholds[] = {
+    0.0 * degree, 0.5 * degree, 1.0 * degree, 1.5 * degree, 2.0 * degree, 2.5 * degree,
+    5.0 * degree, 10.0 * degree, 15.0 * degree, 20.0 * degree, 25.0 * degree,
+    std::numeric_limits<double>::infinity()
+};
+const double confidence_values[] = {
+    1.0, 0.9, 0.8, 0.7, 0.6, 0.5, 0.4, 0.3, 0.2, 0.1, 0.0, 0.0
+};
+
+inline double mapOntoConfidence(double angular_acceleration)
+{
+    std::size_t i = 0;
+    while (angular_acceleration > confidence_thresholds[i]) {
+        ++i;
+    }
+    return confidence_values[i];
+}
+
+} // namespace
+
+auto VehicleDataStore::allocate() -> Slot
+{
+    Slot slot = 0;
+    if (mFreeSlots.empty()) {
+        slot = mUpdated.size();
+        mUpdated.emplace_back();
+        mPosition.emplace_back();
+        mGeoPosition.emplace_back();
+        mSpeed.emplace_back();
+        mAcceleration.emplace_back();
+        mHeading.emplace_back();
+        mYawRate.emplace_back();
+        mCurvature.emplace_back();
+        mConfidence.emplace_back();
+        mCurvatureOutput0.emplace_back();
+        mCurvatureOutput1.emplace_back();
+        mCurvatureSamples.emplace_back();
+        mConfidenceOutput0.emplace_back();
+        mConfidenceOutput1.emplace_back();
+        mConfidenceInput.emplace_back();
+        mStaged.emplace_back();
+    } else {
+        slot = mFreeSlots.back();
+        mFreeSlots.pop_back();
+    }
+
+    mUpdated[slot] = omnetpp::SimTime::getMaxTime();
+    mPosition[slot] = Position();
+    mGeoPosition[slot] = GeoPosition();
+    mSpeed[slot] = 0.0;
+    mAcceleration[slot] = 0.0;
+    mHeading[slot] = 0.0;
+    mYawRate[slot] = 0.0;
+    mCurvature[slot] = 0.0;
+    mConfidence[slot] = 0.0;
+    mCurvatureOutput0[slot] = 0.0;
+    mCurvatureOutput1[slot] = 0.0;
+    mCurvatureSamples[slot] = 0;
+    mConfidenceOutput0[slot] = 0.0;
+    mConfidenceOutput1[slot] = 0.0;
+    mConfidenceInput[slot] = 0.0;
+    mStaged[slot] = false;
+    return slot;
+}
+
+void VehicleDataStore::release(Slot slot)
+{
+    mStaged[slot] = false;
+    mFreeSlots.push_back(slot);
+}
+
+void VehicleDataStore::update(Slot slot, const VehicleKinematics& kinematics)
+{
+    using namespace omnetpp;
+    const SimTime now = simTime();
+    const double delta = (now - mUpdated[slot]).inUnit(SIMTIME_MS) * 1e-3;
+    const double acceleration = kinematics.acceleration.value();
+    const double yaw_rate = kinematics.yaw_rate.value();
+
+    if (delta > 0.0) {
+        if (std::isnan(acceleration)) {
+            mAcceleration[slot] = (kinematics.speed.value() - mSpeed[slot]) / delta;
+        } else {
+            mAcceleration[slot] = acceleration;
+        }
+
+        if (std::isnan(yaw_rate)) {
+            double diff_heading = mHeading[slot] - kinematics.heading.value(); // left turn positive
+            if (diff_heading > pi) {
+                diff_heading -= 2.0 * pi;
+            } else if (diff_heading < -pi) {
+                diff_heading += 2.0 * pi;
+            }
+            mYawRate[slot] = diff_heading / delta;
+        } else {
+            mYawRate[slot] = yaw_rate;
+        }
+    } else if (delta < 0.0) {
+        // initialization
+        mAcceleration[slot] = std::isnan(acceleration) ? 0.0 : acceleration;
+        mYawRate[slot] = std::isnan(yaw_rate) ? 0.0 : yaw_rate;
+    } else {
+        // update has been called for this time step already before
+        return;
+    }
+
+    mPosition[slot] = kinematics.position;
+    mGeoPosition[slot] = kinematics.geo_position;
+    mSpeed[slot] = kinematics.speed.value();
+    mHeading[slot] = kinematics.heading.value();
+    mUpdated[slot] = now;
+    mStaged[slot] = true;
+}
+
+void VehicleDataStore::flush()
+{
+    const std::size_t slots = mStaged.size();
+    for (Slot slot = 0; slot < slots; ++slot) {
+        if (mStaged[slot]) {
+            calculate(slot);
+        }
+    }
+}
+
+void VehicleDataStore::flush(Slot slot)
+{
+    if (mStaged[slot]) {
+        calculate(slot);
+    }
+}
+
+void VehicleDataStore::calculate(Slot slot)
+{
+    const double speed = mSpeed[slot];
+    const double yaw_rate = mYawRate[slot];
+
+    // curvature (left turn positive)
+    if (std::abs(speed) < 1.0) {
+        // assume straight road below minimum speed
+        mCurvature[slot] = 0.0;
+    } else if (mCurvatureSamples[slot] < 2) {
+        // save first two values for initialization
+        mCurvatureOutput1[slot] = mCurvatureOutput0[slot];
+        mCurvatureOutput0[slot] = yaw_rate / speed;
+        ++mCurvatureSamples[slot];
+        mCurvature[slot] = 0.0;
+    } else {
+        const double filtered = (-mCurvatureOutput1[slot] + curvature_b * mCurvatureOutput0[slot] +
+                curvature_c * yaw_rate / speed) / curvature_norm;
+        mCurvatureOutput1[slot] = mCurvatureOutput0[slot];
+        mCurvatureOutput0[slot] = filtered;
+
+        if (std::abs(filtered) < curvature_lower_threshold) {
+            // assume straight road below threshold
+            mCurvature[slot] = 0.0;
+        } else if (std::abs(filtered) > curvature_upper_threshold) {
+            // clamp minimum radius to 1 meter
+            mCurvature[slot] = curvature_upper_threshold;
+        } else {
+            mCurvature[slot] = filtered;
+        }
+    }
+
+    // curvature confidence
+    const double filtered = (-mConfidenceOutput1[slot] + confidence_b * mConfidenceOutput0[slot] +
+            confidence_c * yaw_rate - confidence_c * mConfidenceInput[slot]) / confidence_norm;
+    mConfidenceOutput1[slot] = mConfidenceOutput0[slot];
+    mConfidenceOutput0[slot] = filtered;
+    mConfidenceInput[slot] = yaw_rate;
+    mConfidence[slot] = mapOntoConfidence(std::abs(filtered));
+
+    mStaged[slot] = false;
+}
+
+} // namespace artery
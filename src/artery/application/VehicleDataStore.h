@@ -0,0 +1,92 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_VEHICLEDATASTORE_H_M2RJ8WKE
+#define ARTERY_VEHICLEDATASTORE_H_M2RJ8WKE
+
+#include "artery/application/VehicleKinematics.h"
+#include "artery/utility/Geometry.h"
+#include <omnetpp/simtime.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * VehicleDataStore keeps kinematics and derived data of many vehicles column-wise
+ *
+ * Each VehicleDataProvider occupies one slot of a store.
+ * Kinematics are staged by update() while curvature and its confidence are calculated by flush().
+ * Flushing a store shared by many providers processes all staged slots in one pass over its columns.
+ * Raw values are stored in SI units, i.e. m/s, m/s², rad and rad/s.
+ */
+class VehicleDataStore
+{
+public:
+    using Slot = std::size_t;
+
+    Slot allocate();
+    void release(Slot);
+    std::size_t size() const { return mUpdated.size() - mFreeSlots.size(); }
+
+    /**
+     * Stage kinematics of a vehicle
+     *
+     * Missing acceleration and yaw rate are derived from previous data.
+     * Repeated updates within one millisecond are ignored.
+     */
+    void update(Slot, const VehicleKinematics&);
+
+    /**
+     * Calculate curvature and confidence of all staged slots
+     */
+    void flush();
+
+    /**
+     * Calculate curvature and confidence of a single slot if staged
+     */
+    void flush(Slot);
+
+    omnetpp::SimTime updated(Slot s) const { return mUpdated[s]; }
+    const Position& position(Slot s) const { return mPosition[s]; }
+    const GeoPosition& geo_position(Slot s) const { return mGeoPosition[s]; }
+    double speed(Slot s) const { return mSpeed[s]; }
+    double acceleration(Slot s) const { return mAcceleration[s]; }
+    double heading(Slot s) const { return mHeading[s]; }
+    double yaw_rate(Slot s) const { return mYawRate[s]; }
+    double curvature(Slot s) const { return mCurvature[s]; }
+    double curvature_confidence(Slot s) const { return mConfidence[s]; }
+
+private:
+    void calculate(Slot);
+
+    // kinematics
+    std::vector<omnetpp::SimTime> mUpdated;
+    std::vector<Position> mPosition;
+    std::vector<GeoPosition> mGeoPosition;
+    std::vector<double> mSpeed;
+    std::vector<double> mAcceleration;
+    std::vector<double> mHeading;
+    std::vector<double> mYawRate;
+
+    // derived data and filter states (output [0] is the most recent one)
+    std::vector<double> mCurvature;
+    std::vector<double> mConfidence;
+    std::vector<double> mCurvatureOutput0;
+    std::vector<double> mCurvatureOutput1;
+    std::vector<std::uint8_t> mCurvatureSamples; /*< filter is initialised by two samples */
+    std::vector<double> mConfidenceOutput0;
+    std::vector<double> mConfidenceOutput1;
+    std::vector<double> mConfidenceInput;
+
+    std::vector<std::uint8_t> mStaged;
+    std::vector<Slot> mFreeSlots;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_VEHICLEDATASTORE_H_M2RJ8WKE */
@@ -0,0 +1,43 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/application/VehicleDataUpdater.h"
+#include "traci/BasicNodeManager.h"
+
+using namespace omnetpp;
+
+namespace artery
+{
+
+Define_Module(VehicleDataUpdater)
+
+void VehicleDataUpdater::initialize()
+{
+    mTraci = getModuleByPath(par("traciModule"));
+    if (mTraci) {
+        mTraci->subscribe(traci::BasicNodeManager::updateNodeSignal, this);
+    } else {
+        throw cRuntimeError("No TraCI module found for signal subscription");
+    }
+}
+
+void VehicleDataUpdater::finish()
+{
+    if (mTraci) {
+        mTraci->unsubscribe(traci::BasicNodeManager::updateNodeSignal, this);
+        mTraci = nullptr;
+    }
+    cSimpleModule::finish();
+}
+
+void VehicleDataUpdater::receiveSignal(cComponent*, simsignal_t signal, unsigned long, cObject*)
+{
+    if (signal == traci::BasicNodeManager::updateNodeSignal) {
+        Enter_Method_Silent();
+        mStore->flush();
+    }
+}
+
+} // namespace artery
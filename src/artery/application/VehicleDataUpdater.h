@@ -0,0 +1,40 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_VEHICLEDATAUPDATER_H_C4WQ9ZLN
+#define ARTERY_VEHICLEDATAUPDATER_H_C4WQ9ZLN
+
+#include "artery/application/VehicleDataStore.h"
+#include <omnetpp/clistener.h>
+#include <omnetpp/csimplemodule.h>
+#include <memory>
+
+namespace artery
+{
+
+/**
+ * VehicleDataUpdater provides a VehicleDataStore shared by all attached vehicle data providers
+ *
+ * Providers stage their kinematics while the TraCI node manager updates its vehicles.
+ * Once the node manager has finished its sweep, derived data of all vehicles is calculated in one go.
+ */
+class VehicleDataUpdater : public omnetpp::cSimpleModule, public omnetpp::cListener
+{
+public:
+    std::shared_ptr<VehicleDataStore> getStore() const { return mStore; }
+
+protected:
+    void initialize() override;
+    void finish() override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, unsigned long, omnetpp::cObject*) override;
+
+private:
+    std::shared_ptr<VehicleDataStore> mStore = std::make_shared<VehicleDataStore>();
+    omnetpp::cModule* mTraci = nullptr;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_VEHICLEDATAUPDATER_H_C4WQ9ZLN */
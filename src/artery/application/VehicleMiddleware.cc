@@ -5,6 +5,7 @@
  */
 
 #include "artery/application/StationType.h"
+#include "artery/application/VehicleDataUpdater.h"
 #include "artery/application/VehicleMiddleware.h"
 #include "artery/traci/ControllableVehicle.h"
 #include "artery/traci/MobilityBase.h"
@@ -29,6 +30,10 @@ void VehicleMiddleware::initialize(int stage)
         findHost()->subscribe(MobilityBase::stateChangedSignal, this);
         initializeVehicleController(par("mobilityModule"));
         initializeStationType(mVehicleController->getVehicleClass());
+        if (!par("vehicleDataModule").stdstringValue().empty()) {
+            auto updater = inet::getModuleFromPar<VehicleDataUpdater>(par("vehicleDataModule"), this);
+            mVehicleDataProvider.attach(updater->getStore());
+        }
         getFacilities().register_const(&mVehicleDataProvider);
         mVehicleDataProvider.update(getKinematics(*mVehicleController));
 
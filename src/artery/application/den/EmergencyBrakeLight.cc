@@ -12,7 +12,6 @@
 #include <vanetza/btp/data_request.hpp>
 #include <vanetza/units/acceleration.hpp>
 #include <vanetza/units/velocity.hpp>
-#include <algorithm>
 
 namespace artery
 {
@@ -31,6 +30,7 @@ void EmergencyBrakeLight::initialize(int stage)
 
         mAccelerationSampler.setDuration(par("sampleDuration"));
         mAccelerationSampler.setInterval(par("sampleInterval"));
+        mAccelerationWindow.setCapacity(mAccelerationSampler.buffer().capacity());
         mSpeedThreshold = par("speedThreshold").doubleValue() * meter_per_second;
         mDecelerationThreshold = par("decelerationThreshold").doubleValue() * meter_per_second_squared;
     }
@@ -38,7 +38,9 @@ void EmergencyBrakeLight::initialize(int stage)
 
 void EmergencyBrakeLight::check()
 {
-    mAccelerationSampler.feed(mVdp->acceleration(), mVdp->updated());
+    if (mAccelerationSampler.feed(mVdp->acceleration(), mVdp->updated())) {
+        mAccelerationWindow.insert(mVdp->acceleration(), mVdp->updated());
+    }
     if (!isDetectionBlocked() && checkConditions())
     {
         blockDetection();
@@ -60,11 +62,9 @@ bool EmergencyBrakeLight::checkEgoSpeed() const
 
 bool EmergencyBrakeLight::checkEgoDeceleration() const
 {
-    const auto& samples = mAccelerationSampler.buffer();
-    return samples.full() && std::all_of(samples.begin(), samples.end(),
-        [this](const Sample<vanetza::units::Acceleration>& sample) -> bool {
-            return sample.value < mDecelerationThreshold;
-        });
+    // all samples are below threshold if their maximum is
+    const auto& samples = mAccelerationWindow;
+    return samples.full() && (samples.empty() || samples.max() < mDecelerationThreshold);
 }
 
 vanetza::asn1::Denm EmergencyBrakeLight::createMessage()
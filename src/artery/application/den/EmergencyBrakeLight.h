@@ -9,6 +9,7 @@
 
 #include "artery/application/den/SuspendableUseCase.h"
 #include "artery/application/Sampling.h"
+#include "artery/application/SlidingWindow.h"
 #include <vanetza/units/acceleration.hpp>
 #include <vanetza/units/velocity.hpp>
 
@@ -36,6 +37,7 @@ protected:
 
 private:
     SkipEarlySampler<vanetza::units::Acceleration> mAccelerationSampler;
+    SlidingWindow<vanetza::units::Acceleration> mAccelerationWindow;
     vanetza::units::Velocity mSpeedThreshold;
     vanetza::units::Acceleration mDecelerationThreshold;
 };
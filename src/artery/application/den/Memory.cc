@@ -7,6 +7,8 @@
 #include "artery/application/den/Memory.h"
 #include "artery/application/Timer.h"
 #include <omnetpp/csimulation.h>
+#include <stdexcept>
+#include <string>
 
 using omnetpp::SimTime;
 
@@ -35,56 +37,46 @@ bool operator==(const ActionID& lhs, const ActionID& rhs)
     return lhs.station_id == rhs.station_id && lhs.sequence_number == rhs.sequence_number;
 }
 
-bool operator<(const INTEGER_t& lhs, const INTEGER_t& rhs)
+namespace
 {
-    // TODO this might fail because long is not wide enough (asn1c limitation)
-    long lhs_value = 0, rhs_value = 0;
-    if (asn_INTEGER2long(&lhs, &lhs_value) != 0) {
-        throw std::range_error("lhs value cannot be converted to long");
-    }
-    if (asn_INTEGER2long(&rhs, &rhs_value) != 0) {
-        throw std::range_error("rhs value cannot be converted to long");
-    }
 
-    return lhs_value < rhs_value;
+vanetza::Clock::time_point decode_timestamp(const TimestampIts_t& asn1, const char* field)
+{
+    unsigned long raw = 0;
+    if (asn_INTEGER2ulong(&asn1, &raw) != 0) {
+        throw std::range_error(std::string("DENM ") + field + " cannot be converted to unsigned long");
+    }
+    return vanetza::Clock::time_point { std::chrono::milliseconds(raw) };
 }
 
-Reception::Reception(const DenmObject& object) :
-    timestamp(omnetpp::simTime()),
-    message(object.shared_ptr())
+CauseCode decode_cause_code(const vanetza::asn1::Denm& message)
 {
+    const SituationContainer* situation = message->denm.situation;
+    if (situation) {
+        return convert(situation->eventType.causeCode);
+    } else {
+        return static_cast<CauseCode>(0);
+    }
 }
 
-vanetza::Clock::time_point Reception::expiry() const
+} // namespace
+
+Reception::Reception(const DenmObject& object) :
+    timestamp(omnetpp::simTime()),
+    message(object.shared_ptr()),
+    action_id((*message)->denm.management.actionID),
+    cause_code(decode_cause_code(*message))
 {
-    unsigned long detectionTimeRaw = 0;
     const ManagementContainer_t& denmManagement = (*message)->denm.management;
-    if (asn_INTEGER2ulong(&denmManagement.detectionTime, &detectionTimeRaw) != 0) {
-        throw std::range_error("DENM detectionTime cannot be converted to unsigned long");
-    }
-    vanetza::Clock::time_point detectionTime { std::chrono::milliseconds(detectionTimeRaw) };
+    reference_time = decode_timestamp(denmManagement.referenceTime, "referenceTime");
+    const vanetza::Clock::time_point detectionTime = decode_timestamp(denmManagement.detectionTime, "detectionTime");
 
     vanetza::Clock::duration validityDuration = std::chrono::seconds(600);
     if (denmManagement.validityDuration) {
         validityDuration = std::chrono::seconds(*denmManagement.validityDuration / ValidityDuration_oneSecondAfterDetection);
     }
 
-    return detectionTime + validityDuration;
-}
-
-ActionID Reception::action_id() const
-{
-    return ActionID((*message)->denm.management.actionID);
-}
-
-CauseCode Reception::cause_code() const
-{
-    const SituationContainer* situation = (*message)->denm.situation;
-    if (situation) {
-        return convert(situation->eventType.causeCode);
-    } else {
-        return static_cast<CauseCode>(0);
-    }
+    expiry = detectionTime + validityDuration;
 }
 
 Memory::Memory(const Timer& timer) :
@@ -95,17 +87,13 @@ Memory::Memory(const Timer& timer) :
 void Memory::received(const DenmObject& denm)
 {
     // TODO handle termination DENMs
-    ActionID action_id { denm.asn1()->denm.management.actionID };
+    den::Reception reception { denm };
     auto& idx_action_id = m_container.get<by_action_id>();
-    auto found = idx_action_id.find(action_id);
+    auto found = idx_action_id.find(reception.action_id);
     if (found == idx_action_id.end()) {
-        m_container.insert(den::Reception {denm});
-    } else {
-        const ManagementContainer_t& stored = (*found->message)->denm.management;
-        const ManagementContainer_t& received = denm.asn1()->denm.management;
-        if (stored.referenceTime < received.referenceTime) {
-            idx_action_id.replace(found, den::Reception {denm});
-        }
+        m_container.insert(std::move(reception));
+    } else if (found->reference_time < reception.reference_time) {
+        idx_action_id.replace(found, std::move(reception));
     }
 }
 
@@ -9,7 +9,7 @@
 
 #include "artery/application/DenmObject.h"
 #include <boost/multi_index_container.hpp>
-#include <boost/multi_index/mem_fun.hpp>
+#include <boost/multi_index/member.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/range/iterator_range_core.hpp>
 #include <omnetpp/simtime.h>
@@ -36,6 +36,11 @@ struct ActionID
 bool operator<(const ActionID&, const ActionID&);
 bool operator==(const ActionID&, const ActionID&);
 
+/**
+ * Reception keeps a received DENM along with its decoded keys
+ *
+ * Keys are decoded once on reception, so container look-ups do not touch ASN.1 data.
+ */
 struct Reception
 {
     Reception(const DenmObject&);
@@ -43,9 +48,10 @@ struct Reception
     omnetpp::SimTime timestamp;
     std::shared_ptr<const vanetza::asn1::Denm> message;
 
-    vanetza::Clock::time_point expiry() const;
-    ActionID action_id() const;
-    CauseCode cause_code() const;
+    ActionID action_id;
+    CauseCode cause_code;
+    vanetza::Clock::time_point reference_time;
+    vanetza::Clock::time_point expiry;
 };
 
 class Memory
@@ -58,13 +64,13 @@ class Memory
         boost::multi_index::indexed_by<
             boost::multi_index::ordered_unique<
                 boost::multi_index::tag<by_action_id>,
-                boost::multi_index::const_mem_fun<Reception, ActionID, &Reception::action_id>>,
+                boost::multi_index::member<Reception, ActionID, &Reception::action_id>>,
             boost::multi_index::ordered_non_unique<
                 boost::multi_index::tag<by_expiry>,
-                boost::multi_index::const_mem_fun<Reception, vanetza::Clock::time_point, &Reception::expiry>>,
+                boost::multi_index::member<Reception, vanetza::Clock::time_point, &Reception::expiry>>,
             boost::multi_index::ordered_non_unique<
                 boost::multi_index::tag<by_cause_code>,
-                boost::multi_index::const_mem_fun<Reception, CauseCode, &Reception::cause_code>>
+                boost::multi_index::member<Reception, CauseCode, &Reception::cause_code>>
         >>;
 public:
     using cause_code_iterator = decltype(container_type().get<by_cause_code>().begin());
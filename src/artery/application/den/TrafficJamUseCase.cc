@@ -19,6 +19,7 @@
 #include <vanetza/units/time.hpp>
 #include <vanetza/units/velocity.hpp>
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 
 static const auto hour = 3600.0 * boost::units::si::seconds;
@@ -27,6 +28,20 @@ static const auto km_per_hour = boost::units::si::kilo * boost::units::si::meter
 using omnetpp::SIMTIME_S;
 using omnetpp::SIMTIME_MS;
 
+namespace
+{
+
+// end of queue: deceleration from initial velocity
+const vanetza::units::Velocity initialVelocityThreshold { 80.0 * km_per_hour };
+
+// traffic jam ahead: windows of averaged ego velocity
+const omnetpp::SimTime avgWindowMax {120, SIMTIME_S};
+const omnetpp::SimTime avgWindowMin {10, SIMTIME_S};
+const omnetpp::SimTime stationaryWindowMax {30, SIMTIME_S};
+const omnetpp::SimTime stationaryWindowMin {10, SIMTIME_S};
+
+} // namespace
+
 Define_Module(artery::den::TrafficJamEndOfQueue)
 Define_Module(artery::den::TrafficJamAhead)
 
@@ -49,7 +64,12 @@ void TrafficJamEndOfQueue::initialize(int stage)
 
 void TrafficJamEndOfQueue::check()
 {
-    mVelocitySampler.feed(mVdp->speed(), mVdp->updated());
+    if (mVelocitySampler.feed(mVdp->speed(), mVdp->updated())) {
+        const auto& latest = mVelocitySampler.buffer().latest();
+        if (latest.value >= initialVelocityThreshold) {
+            mInitialVelocity = latest;
+        }
+    }
     if (!isDetectionBlocked() && checkPreconditions() && checkConditions())
     {
         blockDetection();
@@ -86,7 +106,6 @@ bool TrafficJamEndOfQueue::checkEgoDeceleration() const
     using boost::units::si::meter_per_second_squared;
 
     static const Velocity targetVelocityThreshold { 30.0 * km_per_hour };
-    static const Velocity initialVelocityThreshold { 80.0 * km_per_hour };
     static const Acceleration initialDecelThreshold { -0.1 * meter_per_second_squared };
     static const Duration instantDecelDuration { 10.0 * seconds };
     static const Acceleration instantDecelThreshold { -3.5 * meter_per_second_squared };
@@ -96,13 +115,12 @@ bool TrafficJamEndOfQueue::checkEgoDeceleration() const
 
     // current velocity shall not exceed target velocity
     if (!velocitySamples.empty() && velocitySamples.latest().value <= targetVelocityThreshold) {
-        // find the newest sample above initial velocity threshold
-        auto initialVelocity = std::find_if(std::next(velocitySamples.begin()), velocitySamples.end(),
-                [](const Sample<Velocity>& s) { return s.value >= initialVelocityThreshold; });
-        if (initialVelocity != velocitySamples.end()) {
+        // newest sample above initial velocity threshold is only relevant while it is buffered
+        const auto& oldestSample = *std::prev(velocitySamples.end());
+        if (mInitialVelocity && mInitialVelocity->timestamp >= oldestSample.timestamp) {
             // should never fail because only 10s are buffered at all
-            assert(duration(*initialVelocity, velocitySamples.latest()) < instantDecelDuration);
-            fulfilled = differentiate(*initialVelocity, velocitySamples.latest()) < instantDecelThreshold;
+            assert(duration(*mInitialVelocity, velocitySamples.latest()) < instantDecelDuration);
+            fulfilled = differentiate(*mInitialVelocity, velocitySamples.latest()) < instantDecelThreshold;
         }
     }
 
@@ -176,6 +194,10 @@ void TrafficJamAhead::initialize(int stage)
         mDenmMemory = mService->getMemory();
         mVelocitySampler.setDuration(par("sampleDuration"));
         mVelocitySampler.setInterval(par("sampleInterval"));
+        mAverageVelocityWindow.setCapacity(mVelocitySampler.buffer().capacity());
+        mAverageVelocityWindow.setLength(avgWindowMax);
+        mStationaryVelocityWindow.setCapacity(mVelocitySampler.buffer().capacity());
+        mStationaryVelocityWindow.setLength(stationaryWindowMax);
         mUpdateCounter = 0;
         mLocalDynamicMap = &mService->getFacilities().get_const<LocalDynamicMap>();
     }
@@ -183,7 +205,12 @@ void TrafficJamAhead::initialize(int stage)
 
 void TrafficJamAhead::check()
 {
-    mVelocitySampler.feed(mVdp->speed(), mVdp->updated());
+    if (mVelocitySampler.feed(mVdp->speed(), mVdp->updated())) {
+        mAverageVelocityWindow.insert(mVdp->speed(), mVdp->updated());
+        mStationaryVelocityWindow.insert(mVdp->speed(), mVdp->updated());
+    }
+    mAverageVelocityWindow.expire(omnetpp::simTime());
+    mStationaryVelocityWindow.expire(omnetpp::simTime());
     if (!isDetectionBlocked() && checkPreconditions() && checkConditions())
     {
         blockDetection();
@@ -213,17 +240,13 @@ bool TrafficJamAhead::checkConditions()
 
 bool TrafficJamAhead::checkLowAverageEgoVelocity() const
 {
-    static const omnetpp::SimTime avgWindowMax {120, SIMTIME_S};
-    static const omnetpp::SimTime avgWindowMin {10, SIMTIME_S};
-    const auto now = omnetpp::simTime();
     bool lowAvgEgoVelocity = false;
 
     using vanetza::units::Velocity;
-    auto speedSamples = mVelocitySampler.buffer().not_before(now - avgWindowMax);
-    if (speedSamples.duration() >= avgWindowMin) {
+    if (mAverageVelocityWindow.duration() >= avgWindowMin) {
         static const Velocity zeroSpeed { 0.0 * km_per_hour };
         static const Velocity upperSpeed { 30.0 * km_per_hour };
-        const Velocity speedAvg = average(speedSamples);
+        const Velocity speedAvg = mAverageVelocityWindow.mean();
         lowAvgEgoVelocity = speedAvg <= upperSpeed && speedAvg > zeroSpeed;
     }
     return lowAvgEgoVelocity;
@@ -232,14 +255,10 @@ bool TrafficJamAhead::checkLowAverageEgoVelocity() const
 bool TrafficJamAhead::checkStationaryEgo() const
 {
     using vanetza::units::Velocity;
-    static const omnetpp::SimTime maxWindow {30, SIMTIME_S};
-    static const omnetpp::SimTime minWindow {10, SIMTIME_S};
-    const auto now = omnetpp::simTime();
     bool isStationary = false;
-    auto speedSamples = mVelocitySampler.buffer().not_before(now - maxWindow);
-    if (speedSamples.duration() >= minWindow) {
+    if (mStationaryVelocityWindow.duration() >= stationaryWindowMin) {
         static const Velocity zeroSpeed { 0.0 * km_per_hour };
-        const Velocity speedAvg = average(speedSamples);
+        const Velocity speedAvg = mStationaryVelocityWindow.mean();
         isStationary = speedAvg <= zeroSpeed;
     }
     return isStationary;
@@ -253,36 +272,32 @@ bool TrafficJamAhead::checkTrafficJamAheadReceived() const
 
 bool TrafficJamAhead::checkSlowVehiclesAheadByV2X() const
 {
-    using vanetza::facilities::distance;
     using vanetza::facilities::similar_heading;
 
-    LocalDynamicMap::CamPredicate slowVehicles = [&](const LocalDynamicMap::Cam& msg) {
-        bool result = true;
-        // less than 30 km/h, same driving direction and at most 100m distance
-        const SpeedValue_t speedLimit = 833; // 833 cm/s are 29.988 km/h
-        const vanetza::units::Angle headingLimit { 10.0 * vanetza::units::degree };
-        const vanetza::units::Length distLimit { 100.0 * vanetza::units::si::meter };
-
-        const auto& bc = msg->cam.camParameters.basicContainer;
-        const auto& hfc = msg->cam.camParameters.highFrequencyContainer;
-        if (hfc.present == HighFrequencyContainer_PR_basicVehicleContainerHighFrequency) {
-            const auto& bvc = hfc.choice.basicVehicleContainerHighFrequency;
-            const auto& vdp = *mVdp;
-            if (bvc.speed.speedValue == SpeedValue_unavailable ||
-                bvc.speed.speedValue > speedLimit * SpeedValue_oneCentimeterPerSec) {
-                result = false;
-            } else if (!similar_heading(bvc.heading, vdp.heading(), headingLimit)) {
-                result = false;
-            } else if (distance(bc.referencePosition, vdp.latitude(), vdp.longitude()) > distLimit) {
-                return false;
+    // less than 30 km/h, same driving direction and at most 100m distance
+    const float speedLimit = 8.33f; // 8.33 m/s are 29.988 km/h
+    const vanetza::units::Angle headingLimit { 10.0 * vanetza::units::degree };
+    const vanetza::units::Length distLimit { 100.0 * vanetza::units::si::meter };
+
+    const auto& vdp = *mVdp;
+    GeoPosition egoPosition;
+    egoPosition.latitude = vdp.latitude();
+    egoPosition.longitude = vdp.longitude();
+
+    const LocalDynamicMap::CamColumns& cams = mLocalDynamicMap->columns();
+    unsigned slowVehicles = 0;
+    for (const auto& station : mLocalDynamicMap->stationsWithinRadius(egoPosition, distLimit)) {
+        // unavailable speed is NaN and thus fails the comparison
+        const float speed = cams.speed[station.row];
+        const float heading = cams.heading[station.row];
+        if (speed <= speedLimit && !std::isnan(heading)) {
+            const vanetza::units::Angle stationHeading { static_cast<double>(heading) * vanetza::units::degree };
+            if (similar_heading(stationHeading, vdp.heading(), headingLimit)) {
+                ++slowVehicles;
             }
-        } else {
-            result = false;
         }
-
-        return result;
-    };
-    return mLocalDynamicMap->count(slowVehicles) >= 5;
+    }
+    return slowVehicles >= 5;
 }
 
 vanetza::asn1::Denm TrafficJamAhead::createMessage()
@@ -10,7 +10,9 @@
 #include "artery/application/den/Memory.h"
 #include "artery/application/den/SuspendableUseCase.h"
 #include "artery/application/Sampling.h"
+#include "artery/application/SlidingWindow.h"
 #include "artery/application/VehicleDataProvider.h"
+#include <boost/optional/optional.hpp>
 #include <vanetza/units/velocity.hpp>
 
 namespace artery
@@ -56,6 +58,7 @@ private:
     std::shared_ptr<const Memory> mDenmMemory;
     bool mNonUrbanEnvironment;
     SkipEarlySampler<vanetza::units::Velocity> mVelocitySampler;
+    boost::optional<Sample<vanetza::units::Velocity>> mInitialVelocity; /*< newest sample above initial velocity */
 };
 
 class TrafficJamAhead : public SuspendableUseCase
@@ -91,6 +94,8 @@ private:
     bool mNonUrbanEnvironment;
     unsigned mUpdateCounter;
     SkipEarlySampler<vanetza::units::Velocity> mVelocitySampler;
+    SlidingWindow<vanetza::units::Velocity> mAverageVelocityWindow;
+    SlidingWindow<vanetza::units::Velocity> mStationaryVelocityWindow;
 };
 
 } // namespace den
@@ -11,6 +11,7 @@
 #include <boost/math/constants/constants.hpp>
 #include <boost/units/cmath.hpp>
 #include <omnetpp/cexception.h>
+#include <utility>
 
 namespace artery
 {
@@ -73,24 +74,44 @@ transformVehicle(double length, double width, const Position& pos, Angle alpha)
 
 }
 
-EnvironmentModelObject::EnvironmentModelObject(const traci::VehicleController* vehicle, uint32_t id) :
+EnvironmentModelObject::EnvironmentModelObject(const traci::VehicleController* vehicle, uint32_t id, Handle handle) :
+    EnvironmentModelObject(vehicle->getVehicleId(),
+            vehicle->getVehicleType().getLength(), vehicle->getVehicleType().getWidth(),
+            [vehicle]() { return getKinematics(*vehicle); }, id, handle)
+{
+    setStationType(deriveStationTypeFromVehicleClass(vehicle->getVehicleClass()));
+}
+
+EnvironmentModelObject::EnvironmentModelObject(const std::string& externalId, Length length, Length width,
+        KinematicsSource kinematics, uint32_t id, Handle handle) :
     VehicleDataProvider(id),
-    mVehicleController(vehicle),
-    mLength(vehicle->getVehicleType().getLength()),
-    mWidth(vehicle->getVehicleType().getWidth())
+    mExternalId(externalId),
+    mKinematics(std::move(kinematics)),
+    mHandle(handle),
+    mLength(length),
+    mWidth(width),
+    mMoved(false)
 {
     const auto halfWidth = mWidth * 0.5;
     const auto halfLength = mLength * 0.5;
     mRadius = sqrt(halfWidth * halfWidth + halfLength * halfLength);
 
-    setStationType(deriveStationTypeFromVehicleClass(mVehicleController->getVehicleClass()));
     update();
 }
 
-void EnvironmentModelObject::update()
+bool EnvironmentModelObject::update()
 {
+    const Position lastPosition = getVehicleData().position();
+    const auto lastHeading = getVehicleData().heading();
+
     // Update the internal vdp
-    VehicleDataProvider::update(getKinematics(*mVehicleController));
+    VehicleDataProvider::update(mKinematics());
+
+    // parked or queued vehicles keep their outline, i.e. skip costly transformations
+    mMoved = mOutline.empty() || lastPosition != getVehicleData().position() || lastHeading != getVehicleData().heading();
+    if (!mMoved) {
+        return false;
+    }
 
     // Recalculate all time and position dependent attributes
     using namespace boost::math::double_constants;
@@ -102,11 +123,7 @@ void EnvironmentModelObject::update()
     boost::geometry::transform(squareOutline, mOutline, affine);
     mAttachmentPoints.clear();
     boost::geometry::transform(squareAttachmentPoints, mAttachmentPoints, affine);
-}
-
-std::string EnvironmentModelObject::getExternalId() const
-{
-    return mVehicleController->getVehicleId();
+    return true;
 }
 
 const Position& EnvironmentModelObject::getAttachmentPoint(const SensorPosition& pos) const
@@ -14,7 +14,9 @@
 #include "artery/utility/Geometry.h"
 #include <boost/optional/optional.hpp>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace traci { class VehicleController; }
@@ -30,16 +32,49 @@ class EnvironmentModelObject : private VehicleDataProvider
 public:
     using Length = traci::VehicleType::Length;
 
+    /**
+     * Handles are dense integers identifying objects within the environment model.
+     * A handle is stable during the object's lifetime but may be re-used afterwards.
+     */
+    using Handle = uint32_t;
+
+    /**
+     * Source of an object's kinematics, queried at each update
+     */
+    using KinematicsSource = std::function<VehicleKinematics()>;
+
     /**
      * @param ctrl associated VehicleController to this object
      * @param id station ID used by this object for application messages (e.g. CAM)
+     * @param handle environment model's handle for this object
+     */
+    EnvironmentModelObject(const traci::VehicleController*, uint32_t id, Handle handle);
+
+    /**
+     * Create an object not controlled via TraCI, e.g. synthetic objects
+     * @param externalId unique object identifier
+     * @param length object length
+     * @param width object width
+     * @param kinematics source of object's kinematics
+     * @param id station ID used by this object for application messages
+     * @param handle environment model's handle for this object
      */
-    EnvironmentModelObject(const traci::VehicleController*, uint32_t id);
+    EnvironmentModelObject(const std::string& externalId, Length length, Length width,
+            KinematicsSource kinematics, uint32_t id, Handle handle);
 
     /**
      * Updates the internal object data.
+     *
+     * Outline, centre and attachment points are only re-calculated if the object's pose has changed.
+     * @return true if pose has changed
      */
-    void update();
+    bool update();
+
+    /**
+     * Check if object's pose has changed at its last update
+     * @return true if object has moved
+     */
+    bool hasMoved() const { return mMoved; }
 
     /**
      * Returns the polygon describing the object's outline
@@ -56,7 +91,9 @@ public:
 
     const VehicleDataProvider& getVehicleData() const;
 
-    std::string getExternalId() const;
+    const std::string& getExternalId() const { return mExternalId; }
+
+    Handle getHandle() const { return mHandle; }
 
     /**
      * Return the centre point coord of this vehicle object
@@ -77,13 +114,16 @@ public:
     Length getRadius() const { return mRadius; }
 
 private:
-    const traci::VehicleController* mVehicleController;
+    std::string mExternalId;
+    KinematicsSource mKinematics;
+    Handle mHandle;
     traci::VehicleType::Length mLength;
     traci::VehicleType::Length mWidth;
     traci::VehicleType::Length mRadius;
     std::vector<Position> mOutline;
     std::vector<Position> mAttachmentPoints;
     Position mCentrePoint;
+    bool mMoved;
 };
 
 } // namespace artery
@@ -9,17 +9,26 @@
 #include "artery/envmod/GlobalEnvironmentModel.h"
 #include "artery/envmod/Geometry.h"
 #include "artery/envmod/InterdistanceMatrix.h"
+#include "artery/envmod/ObstacleEdgeIndex.h"
+#include "artery/envmod/OcclusionSweep.h"
+#include "artery/envmod/PreselectionGrid.h"
 #include "artery/envmod/PreselectionPolygon.h"
 #include "artery/envmod/PreselectionRtree.h"
+#include "artery/envmod/WorkerPool.h"
 #include "artery/envmod/sensor/SensorConfiguration.h"
 #include "artery/traci/Cast.h"
 #include "artery/traci/ControllableVehicle.h"
+#include "artery/utility/FigurePool.h"
 #include "artery/utility/IdentityRegistry.h"
 #include "traci/Core.h"
 #include <boost/geometry/geometries/register/linestring.hpp>
+#include <boost/math/constants/constants.hpp>
 #include <inet/common/ModuleAccess.h>
 #include <algorithm>
 #include <array>
+#include <cmath>
+#include <numeric>
+#include <tuple>
 
 using namespace omnetpp;
 
@@ -59,37 +68,17 @@ void GlobalEnvironmentModel::refresh()
     mPreselector->update();
     mTainted = false;
 
-    if (mDrawVehicles) {
-        int numObjects = mObjects.size();
-        int numFigures = mDrawVehicles->getNumFigures();
-
-        // add missing polygon figures
-        while (numFigures < numObjects) {
-            auto polygon = new cPolygonFigure();
-            polygon->setFillColor(cFigure::BLUE);
-            polygon->setFilled(true);
-            mDrawVehicles->addFigure(polygon);
-            ++numFigures;
-        }
-
-        // remove excessive polygon figures
-        while (numFigures > numObjects) {
-            --numFigures;
-            delete mDrawVehicles->removeFigure(numFigures);
-        }
+    if (mBatchDetection) {
+        detectBatch();
+    }
 
-        // update figures with current outlines
-        int figureIndex = 0;
+    if (mDrawVehicles) {
+        // re-use polygon figures, only changed outlines are updated
+        mVehicleFigures.begin();
         for (const auto& object : mObjects) {
-            // we add only polygon figures, thus static_cast should be safe
-            auto polygon = static_cast<cPolygonFigure*>(mDrawVehicles->getFigure(figureIndex));
-            std::vector<cFigure::Point> points;
-            for (const Position& pos : object->getOutline()) {
-                points.push_back(cFigure::Point { pos.x.value(), pos.y.value() });
-            }
-            polygon->setPoints(points);
-            ++figureIndex;
+            updateFigurePoints(*mVehicleFigures.acquire(), object->getOutline());
         }
+        mVehicleFigures.end();
     }
 
     emit(refreshSignal, this);
@@ -105,9 +94,41 @@ bool GlobalEnvironmentModel::addVehicle(traci::VehicleController* vehicle)
         }
     }
 
-    auto insertion = mObjects.insert(std::make_shared<EnvironmentModelObject>(vehicle, id));
-    mTainted |= insertion.second; /*< pending preselector update if insertion took place */
-    return insertion.second;
+    return insertObject(vehicle->getVehicleId(), [vehicle, id](EnvironmentModelObject::Handle handle) {
+            return std::make_shared<EnvironmentModelObject>(vehicle, id, handle);
+        });
+}
+
+bool GlobalEnvironmentModel::addObject(const std::string& id, EnvironmentModelObject::Length length,
+        EnvironmentModelObject::Length width, EnvironmentModelObject::KinematicsSource kinematics)
+{
+    return insertObject(id, [&](EnvironmentModelObject::Handle handle) {
+            return std::make_shared<EnvironmentModelObject>(id, length, width, std::move(kinematics), 0, handle);
+        });
+}
+
+bool GlobalEnvironmentModel::insertObject(const std::string& id,
+        const std::function<std::shared_ptr<EnvironmentModelObject>(EnvironmentModelObject::Handle)>& factory)
+{
+    if (mObjects.find(id) != mObjects.end()) {
+        return false;
+    }
+
+    // re-use handles of removed objects to keep handles dense
+    EnvironmentModelObject::Handle handle = mObjectHandles.size();
+    if (!mFreeHandles.empty()) {
+        handle = mFreeHandles.back();
+        mFreeHandles.pop_back();
+    } else {
+        mObjectHandles.emplace_back();
+    }
+
+    auto object = factory(handle);
+    mObjectHandles[handle] = object;
+    mObjects.insert(object);
+    mPreselector->insert(*object);
+    mTainted = true; /*< pending preselector update */
+    return true;
 }
 
 bool GlobalEnvironmentModel::addObstacle(std::string id, std::vector<Position> outline)
@@ -144,29 +165,48 @@ void GlobalEnvironmentModel::buildObstacleRtree()
         if (boost::geometry::is_valid(polygon, message)) {
             auto bb = boost::geometry::return_envelope<geometry::Box>(polygon);
             mObstacleRtree.insert(std::make_pair(bb, obstacle->getObstacleId()));
+            if (mObstacleEdgeIndex) {
+                mObstacleEdgeIndex->add(polygon);
+            }
         } else {
             throw std::runtime_error("invalid obstacle polygon #" + obstacle->getObstacleId() + " : " + message);
         }
     }
+
+    ++mObstacleGeneration; /*< invalidate sensor footprints */
+    if (mObstacleEdgeIndex) {
+        mObstacleEdgeIndex->build();
+        EV_INFO << "envmod: Obstacle edge index with " << mObstacleEdgeIndex->size() << " edges\n";
+    }
 }
 
 bool GlobalEnvironmentModel::removeVehicle(std::string objID)
 {
     mTainted = true; /*< pending preselector update */
-    return mObjects.erase(objID) > 0;
+    auto found = mObjects.find(objID);
+    if (found != mObjects.end()) {
+        const EnvironmentModelObject::Handle handle = (*found)->getHandle();
+        mPreselector->remove(**found);
+        mObjects.erase(found);
+        mObjectHandles[handle].reset();
+        mFreeHandles.push_back(handle);
+        ++mObjectRemovals;
+        return true;
+    }
+    return false;
 }
 
 void GlobalEnvironmentModel::removeVehicles()
 {
+    mObjectRemovals += mObjects.size();
     mObjects.clear();
+    mObjectHandles.clear();
+    mFreeHandles.clear();
     mPreselector->update();
     mTainted = false;
 
     if (mDrawVehicles) {
-        // remove all polygons
-        for (int i = mDrawVehicles->getNumFigures() - 1; i >= 0; --i) {
-            delete mDrawVehicles->removeFigure(i);
-        }
+        mVehicleFigures.clear();
     }
 }
 
@@ -175,6 +215,10 @@ void GlobalEnvironmentModel::clear()
     removeVehicles();
     mObstacles.clear();
     mObstacleRtree.clear();
+    ++mObstacleGeneration;
+    if (mObstacleEdgeIndex) {
+        mObstacleEdgeIndex->clear();
+    }
 }
 
 SensorDetection GlobalEnvironmentModel::detectObjects(const SensorConfigRadar& config)
@@ -190,30 +234,62 @@ SensorDetection GlobalEnvironmentModel::detectObjects(const SensorConfigRadar& c
 
     SensorDetection detection;
 
-    // create sensor cone
     const auto& egoObj = getObject(config.egoID);
     if (!egoObj) {
         throw std::runtime_error("no object found for ID " + config.egoID);
     }
-    detection.sensorCone = createSensorArc(config, *egoObj);
+
+    // sensor cone and static obstacles in sight, possibly cached from a previous detection
+    std::unique_ptr<SensorFootprint> transientFootprint;
+    SensorFootprint* footprint = findFootprint(config);
+    if (!footprint) {
+        transientFootprint.reset(new SensorFootprint());
+        footprint = transientFootprint.get();
+    }
+    if (!isFootprintValid(*footprint, config, *egoObj)) {
+        buildFootprint(*footprint, config, *egoObj);
+    }
+    detection.sensorCone = footprint->cone;
 
     assert(mPreselector);
-    std::vector<std::string> preselObjectsInSensorRange = mPreselector->select(*egoObj, config);
+    std::vector<EnvironmentModelObject::Handle> preselObjectsInSensorRange = mPreselector->select(*egoObj, config);
 
-    // get obstacles intersecting with sensor cone
-    std::vector<ObstacleRtreeValue> obstacleIntersections;
-    geometry::Polygon tmp; /*< Boost 1.61 fails when detection.sensorCone is used directly in R-Tree query */
-    bg::convert(detection.sensorCone, tmp);
-    mObstacleRtree.query(bg::index::intersects(tmp), std::back_inserter(obstacleIntersections));
+    const Position& egoPointPosition = footprint->origin;
+    const std::vector<const EnvironmentModelObstacle*>& obstacles = footprint->obstacles;
 
-    const auto& egoPointPosition = getObject(config.egoID)->getAttachmentPoint(config.sensorPosition);
+    // resolve preselected objects only once
+    std::vector<std::shared_ptr<EnvironmentModelObject>> preselObjects;
+    preselObjects.reserve(preselObjectsInSensorRange.size());
+    for (EnvironmentModelObject::Handle handle : preselObjectsInSensorRange) {
+        preselObjects.push_back(mObjectHandles[handle]);
+    }
 
-    if (config.doLineOfSightCheck)
+    if (config.doLineOfSightCheck && footprint->originWithinObstacle)
     {
+        // every line of sight starts inside an obstacle, thus nothing is visible
+    }
+    else if (config.doLineOfSightCheck)
+    {
+        // objects are indexed by a sweep per detection, obstacles by the footprint's sweep
+        std::unique_ptr<OcclusionSweep> sweep;
+        if (mOcclusionSweep) {
+            sweep.reset(new OcclusionSweep(egoPointPosition));
+            for (const auto& object : preselObjects) {
+                sweep->add(object->getOutline());
+            }
+            sweep->build();
+        }
+
+        auto isOccultedByObject = [&](const LineOfSight& lineOfSight, OcclusionSweep::Occluder occluder) {
+            return bg::crosses(lineOfSight, preselObjects[occluder]->getOutline());
+        };
+        auto isOccultedByObstacle = [&](const LineOfSight& lineOfSight, OcclusionSweep::Occluder occluder) {
+            return bg::intersects(lineOfSight, obstacles[occluder]->getOutline());
+        };
+
         // check if objects in sensor cone are hidden by another object or an obstacle
-        for (const auto& objectId : preselObjectsInSensorRange)
+        for (const auto& object : preselObjects)
         {
-            const auto& object = getObject(objectId);
             for (const auto& objectPoint : object->getOutline())
             {
                 // skip objects points outside of sensor cone
@@ -225,18 +301,31 @@ SensorDetection GlobalEnvironmentModel::detectObjects(const SensorConfigRadar& c
                 lineOfSight[0] = egoPointPosition;
                 lineOfSight[1] = objectPoint;
 
-                bool noVehicleOccultation = std::none_of(preselObjectsInSensorRange.begin(), preselObjectsInSensorRange.end(),
-                        [&](const std::string& objectId) {
-                            const std::vector<Position>& objectOutline = getObject(objectId)->getOutline();
-                            return bg::crosses(lineOfSight, objectOutline);
-                        });
-                bool noObstacleOccultation = std::none_of(obstacleIntersections.begin(), obstacleIntersections.end(),
-                        [&](const ObstacleRtreeValue& obstacleIntersection) {
-                            const auto& obstacle = mObstacles.at(obstacleIntersection.second);
-                            return bg::intersects(lineOfSight, obstacle->getOutline());
-                        });
-
-                if (noVehicleOccultation && noObstacleOccultation) {
+                bool noOccultation = true;
+                if (sweep) {
+                    // only occluders covering the bearing of this object point are of interest
+                    const auto& candidates = sweep->query(objectPoint);
+                    noOccultation = std::none_of(candidates.begin(), candidates.end(),
+                            [&](OcclusionSweep::Occluder occluder) { return isOccultedByObject(lineOfSight, occluder); });
+                    if (noOccultation && footprint->obstacleSweep) {
+                        const auto& obstacleCandidates = footprint->obstacleSweep->query(objectPoint);
+                        noOccultation = std::none_of(obstacleCandidates.begin(), obstacleCandidates.end(),
+                                [&](OcclusionSweep::Occluder occluder) { return isOccultedByObstacle(lineOfSight, occluder); });
+                    }
+                } else {
+                    for (OcclusionSweep::Occluder occluder = 0; noOccultation && occluder < preselObjects.size(); ++occluder) {
+                        noOccultation = !isOccultedByObject(lineOfSight, occluder);
+                    }
+                    for (OcclusionSweep::Occluder occluder = 0; noOccultation && occluder < obstacles.size(); ++occluder) {
+                        noOccultation = !isOccultedByObstacle(lineOfSight, occluder);
+                    }
+                }
+
+                if (noOccultation && mObstacleEdgeIndex) {
+                    noOccultation = !mObstacleEdgeIndex->intersects(egoPointPosition, objectPoint);
+                }
+
+                if (noOccultation) {
                     if (detection.objects.empty() || detection.objects.back() != object) {
                         detection.objects.push_back(object);
                     }
@@ -251,14 +340,185 @@ SensorDetection GlobalEnvironmentModel::detectObjects(const SensorConfigRadar& c
             } // for each (corner) point of object polygon
         } // for each object
     } else {
-        for (const auto& objectId : preselObjectsInSensorRange) {
-            detection.objects.push_back(getObject(objectId));
-        }
+        detection.objects.assign(preselObjects.begin(), preselObjects.end());
     }
 
     return detection;
 }
 
+GlobalEnvironmentModel::SensorFootprint* GlobalEnvironmentModel::findFootprint(const SensorConfigRadar& config)
+{
+    if (!mFootprintCache) {
+        return nullptr;
+    }
+
+    // batched detections run concurrently, but each footprint is used by a single worker only
+    std::lock_guard<std::mutex> lock(mFootprintMutex);
+    return &mFootprints[&config];
+}
+
+bool GlobalEnvironmentModel::isFootprintValid(const SensorFootprint& footprint, const SensorConfigRadar& config,
+        const EnvironmentModelObject& ego) const
+{
+    using boost::math::double_constants::pi;
+    using boost::math::double_constants::two_pi;
+
+    if (!footprint.valid || footprint.obstacleGeneration != mObstacleGeneration) {
+        return false;
+    } else if (footprint.egoID != config.egoID || footprint.sensorID != config.sensorID) {
+        // configuration's memory has been re-used by another sensor
+        return false;
+    }
+
+    const Position& origin = ego.getAttachmentPoint(config.sensorPosition);
+    if (distance(origin, footprint.origin).value() > mFootprintTolerance) {
+        return false;
+    }
+
+    double deltaHeading = std::fmod(std::abs(ego.getVehicleData().heading() / boost::units::si::radian - footprint.heading), two_pi);
+    if (deltaHeading > pi) {
+        deltaHeading = two_pi - deltaHeading;
+    }
+    return deltaHeading <= mFootprintAngleTolerance;
+}
+
+void GlobalEnvironmentModel::buildFootprint(SensorFootprint& footprint, const SensorConfigRadar& config,
+        const EnvironmentModelObject& ego) const
+{
+    namespace bg = boost::geometry;
+
+    footprint.egoID = config.egoID;
+    footprint.sensorID = config.sensorID;
+    footprint.origin = ego.getAttachmentPoint(config.sensorPosition);
+    footprint.heading = ego.getVehicleData().heading() / boost::units::si::radian;
+    footprint.cone = createSensorArc(config, footprint.origin, ego.getVehicleData().heading());
+    footprint.obstacles.clear();
+    footprint.obstacleSweep.reset();
+    footprint.originWithinObstacle = false;
+    footprint.obstacleGeneration = mObstacleGeneration;
+    footprint.valid = true;
+
+    if (!config.doLineOfSightCheck) {
+        // obstacles matter only for line of sight checks
+        return;
+    }
+
+    if (!mObstacleEdgeIndex) {
+        // get obstacles intersecting with sensor cone
+        std::vector<ObstacleRtreeValue> obstacleIntersections;
+        geometry::Polygon tmp; /*< Boost 1.61 fails when sensor cone is used directly in R-Tree query */
+        bg::convert(footprint.cone, tmp);
+        mObstacleRtree.query(bg::index::intersects(tmp), std::back_inserter(obstacleIntersections));
+
+        footprint.obstacles.reserve(obstacleIntersections.size());
+        for (const auto& obstacleIntersection : obstacleIntersections) {
+            footprint.obstacles.push_back(mObstacles.at(obstacleIntersection.second).get());
+        }
+
+        if (mOcclusionSweep && !footprint.obstacles.empty()) {
+            footprint.obstacleSweep.reset(new OcclusionSweep(footprint.origin));
+            for (const auto* obstacle : footprint.obstacles) {
+                footprint.obstacleSweep->add(obstacle->getOutline());
+            }
+            footprint.obstacleSweep->build();
+        }
+    } else {
+        // edge index misses lines of sight running entirely inside an obstacle (polygon tests catch them)
+        std::vector<ObstacleRtreeValue> enclosing;
+        mObstacleRtree.query(bg::index::intersects(footprint.origin), std::back_inserter(enclosing));
+        footprint.originWithinObstacle = std::any_of(enclosing.begin(), enclosing.end(), [&](const ObstacleRtreeValue& value) {
+                return bg::covered_by(footprint.origin, mObstacles.at(value.second)->getOutline());
+            });
+    }
+}
+
+void GlobalEnvironmentModel::registerDetection(const SensorConfigRadar& config, std::function<bool()> due)
+{
+    if (mBatchIndex.emplace(&config, mBatch.size()).second) {
+        mBatch.push_back(BatchedDetection { &config, SensorDetection {}, false, std::move(due) });
+        mBatchRegrouping = true;
+    }
+}
+
+void GlobalEnvironmentModel::unregisterDetection(const SensorConfigRadar& config)
+{
+    auto found = mBatchIndex.find(&config);
+    if (found != mBatchIndex.end()) {
+        const std::size_t index = found->second;
+        mBatchIndex.erase(found);
+        if (index + 1 != mBatch.size()) {
+            mBatch[index] = std::move(mBatch.back());
+            mBatchIndex[mBatch[index].config] = index;
+        }
+        mBatch.pop_back();
+        mBatchRegrouping = true;
+    }
+
+    mFootprints.erase(&config);
+}
+
+SensorDetection GlobalEnvironmentModel::fetchDetection(const SensorConfigRadar& config)
+{
+    auto found = mBatchIndex.find(&config);
+    if (found != mBatchIndex.end()) {
+        BatchedDetection& batched = mBatch[found->second];
+        if (batched.valid) {
+            batched.valid = false;
+            return std::move(batched.detection);
+        }
+    }
+
+    return detectObjects(config);
+}
+
+void GlobalEnvironmentModel::detectBatch()
+{
+    if (mBatchRegrouping) {
+        // egoID is assigned during sensor initialization, hence grouping is deferred until here
+        mBatchOrder.resize(mBatch.size());
+        std::iota(mBatchOrder.begin(), mBatchOrder.end(), 0);
+        std::sort(mBatchOrder.begin(), mBatchOrder.end(), [this](std::size_t a, std::size_t b) {
+                const SensorConfigRadar& configA = *mBatch[a].config;
+                const SensorConfigRadar& configB = *mBatch[b].config;
+                return std::tie(configA.egoID, configA.sensorID) < std::tie(configB.egoID, configB.sensorID);
+            });
+
+        mBatchGroups.clear();
+        for (std::size_t i = 0; i < mBatchOrder.size(); ++i) {
+            if (i == 0 || mBatch[mBatchOrder[i]].config->egoID != mBatch[mBatchOrder[i - 1]].config->egoID) {
+                mBatchGroups.push_back(i);
+            }
+        }
+        mBatchRegrouping = false;
+    }
+
+    // decide serially which detections are needed, predicates are not required to be thread-safe
+    for (BatchedDetection& batched : mBatch) {
+        // ego may have left the simulation already, its sensor falls back to detectObjects then
+        batched.valid = (!batched.due || batched.due()) && mObjects.find(batched.config->egoID) != mObjects.end();
+    }
+
+    const std::size_t numGroups = mBatchGroups.size();
+    mWorkerPool->run(numGroups, [this, numGroups](std::size_t group) {
+            const std::size_t begin = mBatchGroups[group];
+            const std::size_t end = group + 1 < numGroups ? mBatchGroups[group + 1] : mBatchOrder.size();
+            for (std::size_t i = begin; i < end; ++i) {
+                BatchedDetection& batched = mBatch[mBatchOrder[i]];
+                if (batched.valid) {
+                    batched.detection = detectObjects(*batched.config);
+                }
+            }
+        });
+}
+
+double GlobalEnvironmentModel::getMeasurementPhase()
+{
+    // low-discrepancy sequence: any number of consecutive phases covers [0; 1) evenly
+    const double phase = mMeasurementPhase;
+    mMeasurementPhase = std::fmod(mMeasurementPhase + boost::math::double_constants::phi - 1.0, 1.0);
+    return phase;
+}
+
 void GlobalEnvironmentModel::initialize()
 {
     const int preselectionMethod = par("preselectionMethod");
@@ -279,11 +539,18 @@ void GlobalEnvironmentModel::initialize()
         mPreselector.reset(new PreselectionRtree(mObjects));
         break;
 
+    case 4:
+        EV_INFO << "envmod: Preselection by uniform grid\n";
+        mPreselector.reset(new PreselectionGrid(mObjects, par("preselectionGridCellSize").doubleValue()));
+        break;
+
     default:
         throw cRuntimeError("Unknown preselection method");
     }
 
-    cModule* traci = getModuleByPath(par("traciModule"));
+    // objects of derived models might be fed otherwise, e.g. by a benchmark
+    const std::string traciModule = par("traciModule").stdstringValue();
+    cModule* traci = traciModule.empty() ? nullptr : getModuleByPath(traciModule.c_str());
     if (traci) {
         traci->subscribe(traciInitSignal, this);
         traci->subscribe(traciCloseSignal, this);
@@ -291,7 +558,7 @@ void GlobalEnvironmentModel::initialize()
         traci->subscribe(traciNodeAddSignal, this);
         traci->subscribe(traciNodeRemoveSignal, this);
         traci->subscribe(traciNodeUpdateSignal, this);
-    } else {
+    } else if (!traciModule.empty()) {
         throw cRuntimeError("No TraCI module found for signal subscription");
     }
 
@@ -306,10 +573,41 @@ void GlobalEnvironmentModel::initialize()
     if (par("drawVehicles")) {
         mDrawVehicles = new omnetpp::cGroupFigure("vehicles");
         getCanvas()->addFigure(mDrawVehicles);
+        mVehicleFigures.attach(mDrawVehicles, [](cPolygonFigure* polygon) {
+                polygon->setFillColor(cFigure::BLUE);
+                polygon->setFilled(true);
+            });
     }
 
     std::string obstacleTypes = par("obstacleTypes");
     boost::split(mObstacleTypes, obstacleTypes, boost::is_any_of(" "));
+
+    const std::string occlusionEngine = par("occlusionEngine");
+    if (occlusionEngine == "pairwise") {
+        mOcclusionSweep = false;
+    } else if (occlusionEngine == "sweep") {
+        mOcclusionSweep = true;
+    } else {
+        throw cRuntimeError("Unknown occlusion engine \"%s\"", occlusionEngine.c_str());
+    }
+
+    if (par("obstacleEdgeIndex")) {
+        mObstacleEdgeIndex.reset(new ObstacleEdgeIndex(par("obstacleEdgeCellSize").doubleValue()));
+    }
+
+    mFootprintCache = par("sensorFootprintCache");
+    mFootprintTolerance = par("sensorFootprintTolerance");
+    mFootprintAngleTolerance = par("sensorFootprintAngleTolerance").doubleValue() * boost::math::double_constants::degree;
+
+    mBatchDetection = par("batchDetection");
+    if (mBatchDetection) {
+        const int detectionThreads = par("detectionThreads");
+        if (detectionThreads < 0) {
+            throw cRuntimeError("Number of detection threads must not be negative");
+        }
+        mWorkerPool.reset(new WorkerPool(detectionThreads));
+        EV_INFO << "envmod: Batched detection by " << mWorkerPool->size() << " threads\n";
+    }
 }
 
 void GlobalEnvironmentModel::finish()
@@ -390,4 +688,9 @@ std::shared_ptr<EnvironmentModelObject> GlobalEnvironmentModel::getObject(const
     return found != mObjects.end() ? *found : nullptr;
 }
 
+std::shared_ptr<EnvironmentModelObject> GlobalEnvironmentModel::getObject(EnvironmentModelObject::Handle handle) const
+{
+    return handle < mObjectHandles.size() ? mObjectHandles[handle] : nullptr;
+}
+
 } // namespace artery
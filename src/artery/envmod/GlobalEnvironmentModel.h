@@ -11,6 +11,7 @@
 #include "artery/envmod/sensor/SensorDetection.h"
 #include "artery/envmod/Geometry.h"
 #include "artery/envmod/EnvironmentModelObject.h"
+#include "artery/utility/FigurePool.h"
 #include "artery/utility/Geometry.h"
 #include <omnetpp/ccanvas.h>
 #include <omnetpp/clistener.h>
@@ -19,9 +20,13 @@
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 
 namespace traci {
@@ -34,7 +39,10 @@ namespace artery
 
 class EnvironmentModelObstacle;
 class IdentityRegistry;
+class ObstacleEdgeIndex;
+class OcclusionSweep;
 class PreselectionMethod;
+class WorkerPool;
 
 /**
  * Implementation of the environment model.
@@ -61,6 +69,31 @@ public:
      */
     std::shared_ptr<EnvironmentModelObject> getObject(const std::string& objId);
 
+    /**
+     * Fetch an object by its handle.
+     * @param handle object handle
+     * @return model object matching handle
+     */
+    std::shared_ptr<EnvironmentModelObject> getObject(EnvironmentModelObject::Handle handle) const;
+
+    /**
+     * Number of object removals since start of simulation
+     *
+     * Observers keeping references to objects can skip checking for removed objects
+     * as long as this counter is unchanged.
+     * @return removal counter
+     */
+    unsigned long getObjectRemovals() const { return mObjectRemovals; }
+
+    /**
+     * Get phase for a periodic sensor measurement
+     *
+     * Consecutive phases are spread evenly (golden ratio sequence), i.e. measurements
+     * of all sensors are staggered across their measurement interval.
+     * @return phase as fraction of measurement interval in range [0; 1)
+     */
+    double getMeasurementPhase();
+
     /**
      * Returns GSDE of all objects in a sensor area defined by the sensor configuration
      * @param config
@@ -68,18 +101,52 @@ public:
      */
     SensorDetection detectObjects(const SensorConfigRadar&);
 
+    /**
+     * Register sensor configuration for the batched detection pass
+     *
+     * Detections of all registered configurations are computed at once after each refresh
+     * if batched detection is enabled. Configuration has to stay valid until unregistered.
+     * @param config radar sensor configuration
+     * @param due predicate telling if detection is needed at current refresh (always if empty)
+     */
+    void registerDetection(const SensorConfigRadar&, std::function<bool()> due = nullptr);
+
+    /**
+     * Unregister sensor configuration from the batched detection pass
+     * @param config previously registered radar sensor configuration
+     */
+    void unregisterDetection(const SensorConfigRadar&);
+
+    /**
+     * Fetch detection result of a sensor configuration
+     *
+     * The result of the batched detection pass is handed over if available,
+     * otherwise the objects are detected right away (see detectObjects).
+     * @param config radar sensor configuration
+     * @return sensor detection
+     */
+    SensorDetection fetchDetection(const SensorConfigRadar&);
+
     using ObjectDB = boost::multi_index_container<
         std::shared_ptr<EnvironmentModelObject>,
         boost::multi_index::indexed_by<
             boost::multi_index::ordered_unique<
-                boost::multi_index::const_mem_fun<EnvironmentModelObject, std::string, &EnvironmentModelObject::getExternalId>>>>;
+                boost::multi_index::const_mem_fun<EnvironmentModelObject, const std::string&, &EnvironmentModelObject::getExternalId>>>>;
 
-private:
+protected:
     /**
      * Refresh all dynamic objects in the database.
      */
     void refresh();
 
+    /**
+     * Detect objects of all registered sensor configurations
+     *
+     * Detections of sensors mounted at the same ego object are computed by the same worker
+     * because preselection methods may update per-ego data lazily.
+     */
+    void detectBatch();
+
     /**
      * Add vehicle to the environment database
      * @param vehicle TraCI mobility corresponding to vehicle
@@ -87,6 +154,17 @@ private:
      */
     bool addVehicle(traci::VehicleController* vehicle);
 
+    /**
+     * Add an object not controlled via TraCI to the environment database, e.g. synthetic objects
+     * @param id unique object identifier
+     * @param length object length
+     * @param width object width
+     * @param kinematics source of object's kinematics queried at each refresh
+     * @return true if successful
+     */
+    bool addObject(const std::string& id, EnvironmentModelObject::Length length, EnvironmentModelObject::Length width,
+            EnvironmentModelObject::KinematicsSource kinematics);
+
     /**
      * Remove vehicle from the database
      * @param nodeId TraCI id of vehicle to be removed
@@ -108,7 +186,7 @@ private:
     bool addObstacle(std::string id, std::vector<Position> outline);
 
     /**
-     * Create the obstacle rtree.
+     * Create the obstacle rtree (and obstacle edge index if enabled).
      * This method should be called after all static obstacles have been added.
      */
     void buildObstacleRtree();
@@ -131,18 +209,89 @@ private:
      */
     virtual traci::VehicleController* getVehicleController(omnetpp::cModule* mod);
 
+private:
+    /**
+     * Insert a new object into the database
+     * @param id object's external id
+     * @param factory creates object with given handle
+     * @return true if successful
+     */
+    bool insertObject(const std::string& id, const std::function<std::shared_ptr<EnvironmentModelObject>(EnvironmentModelObject::Handle)>& factory);
+
+    /**
+     * Sensor cone and static obstacles as seen by a sensor at a particular ego pose
+     */
+    struct SensorFootprint
+    {
+        std::string egoID;
+        unsigned sensorID = 0;
+        Position origin; /*< sensor attachment point */
+        double heading = 0.0; /*< ego heading in radian */
+        std::vector<Position> cone;
+        std::vector<const EnvironmentModelObstacle*> obstacles; /*< obstacles intersecting cone */
+        std::unique_ptr<OcclusionSweep> obstacleSweep; /*< angular index of obstacles (sweep engine only) */
+        bool originWithinObstacle = false; /*< only determined if obstacle edge index is used */
+        unsigned long obstacleGeneration = 0;
+        bool valid = false;
+    };
+
+    /**
+     * Find cached footprint of a sensor
+     * @param config radar sensor configuration
+     * @return footprint (possibly not yet valid) or nullptr if caching is disabled
+     */
+    SensorFootprint* findFootprint(const SensorConfigRadar&);
+
+    /**
+     * Check if footprint still matches the sensor's current pose within tolerances
+     */
+    bool isFootprintValid(const SensorFootprint&, const SensorConfigRadar&, const EnvironmentModelObject& ego) const;
+
+    /**
+     * (Re-)build footprint for the sensor's current pose
+     */
+    void buildFootprint(SensorFootprint&, const SensorConfigRadar&, const EnvironmentModelObject& ego) const;
+
+    struct BatchedDetection
+    {
+        const SensorConfigRadar* config;
+        SensorDetection detection;
+        bool valid;
+        std::function<bool()> due;
+    };
+
     using ObstacleDB = std::map<std::string, std::shared_ptr<EnvironmentModelObstacle>>;
     using ObstacleRtreeValue = std::pair<geometry::Box, std::string>;
 
     ObjectDB mObjects;
+    std::vector<std::shared_ptr<EnvironmentModelObject>> mObjectHandles; /*< objects indexed by their handles */
+    std::vector<EnvironmentModelObject::Handle> mFreeHandles;
+    unsigned long mObjectRemovals = 0;
     ObstacleDB mObstacles;
     boost::geometry::index::rtree<ObstacleRtreeValue, boost::geometry::index::rstar<16>> mObstacleRtree;
+    std::unique_ptr<ObstacleEdgeIndex> mObstacleEdgeIndex; /*< optional, replaces obstacle polygons in line of sight checks */
+    unsigned long mObstacleGeneration = 0; /*< incremented whenever the obstacle database changes */
     std::unique_ptr<PreselectionMethod> mPreselector;
     IdentityRegistry* mIdentityRegistry;
     bool mTainted;
     omnetpp::cGroupFigure* mDrawObstacles = nullptr;
     omnetpp::cGroupFigure* mDrawVehicles = nullptr;
+    FigurePool<omnetpp::cPolygonFigure> mVehicleFigures;
     std::set<std::string> mObstacleTypes;
+    bool mOcclusionSweep = false;
+    bool mBatchDetection = false;
+    std::unique_ptr<WorkerPool> mWorkerPool;
+    std::vector<BatchedDetection> mBatch;
+    std::unordered_map<const SensorConfigRadar*, std::size_t> mBatchIndex;
+    std::vector<std::size_t> mBatchOrder; /*< mBatch indices grouped by ego */
+    std::vector<std::size_t> mBatchGroups; /*< begin of each ego group in mBatchOrder */
+    bool mBatchRegrouping = false;
+    double mMeasurementPhase = 0.0;
+    bool mFootprintCache = false;
+    double mFootprintTolerance = 0.0; /*< meter */
+    double mFootprintAngleTolerance = 0.0; /*< radian */
+    std::unordered_map<const SensorConfigRadar*, SensorFootprint> mFootprints;
+    std::mutex mFootprintMutex;
 };
 
 } // namespace artery
@@ -7,6 +7,7 @@
 #include "artery/envmod/InterdistanceMatrix.h"
 #include "artery/envmod/Geometry.h"
 #include "artery/envmod/sensor/SensorConfiguration.h"
+#include <boost/math/constants/constants.hpp>
 #include <boost/units/systems/angle/degrees.hpp>
 #include <cmath>
 
@@ -18,75 +19,102 @@ namespace artery
 
 namespace {
 
-/**
- * Calculates the angle between two points using an centre point
- * @param p1 Point 1
- * @param p2 Point 2
- * @param centre Centre point
- * @return Angle between the two points
+/*
+ * Kernels operate on plain contiguous arrays without branches in their loop bodies,
+ * i.e. compilers are able to vectorize them.
  */
-Angle createAngle(geometry::Point p1, geometry::Point p2, geometry::Point centre)
-{
-    geom::subtract_point(p1, centre);
-    geom::subtract_point(p2, centre);
 
-    double angle1 = atan2(p1.get<0>(), p1.get<1>());
-    double angle2 = atan2(p2.get<0>(), p2.get<1>());
+void computeDistances(const double* xs, const double* ys, double x0, double y0, double* out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        const double dx = xs[i] - x0;
+        const double dy = ys[i] - y0;
+        out[i] = std::sqrt(dx * dx + dy * dy);
+    }
+}
 
+void computeAngles(const double* xs, const double* ys, double x0, double y0, double reference, double* out, std::size_t n)
+{
     using namespace boost::math::double_constants;
-    double radAngle { angle2 - angle1 }; // range [-2pi; 2pi]
-    if (radAngle >  pi) {
-        radAngle -= 2.0 * pi;
-    } else if (radAngle < -pi) {
-        radAngle += 2.0 * pi;
+    for (std::size_t i = 0; i < n; ++i) {
+        double radAngle = std::atan2(xs[i] - x0, ys[i] - y0) - reference; // range [-2pi; 2pi]
+        radAngle -= (radAngle > pi) * two_pi;
+        radAngle += (radAngle < -pi) * two_pi;
+        out[i] = radAngle * radian;
     }
-    return radAngle * boost::units::si::radian;
 }
 
-}
+} // namespace
 
 void InterdistanceMatrix::update()
 {
-    mMatrix.clear();
-
-    for (const auto& objEgo : mObjects) {
-        std::list<MatrixItem> xs;
-        for (const auto& objX : mObjects) {
-            if (objEgo->getExternalId() != objX->getExternalId()) {
-                const double distance = geom::distance(objEgo->getCentrePoint(), objX->getCentrePoint());
-                double angle = calcAngleEgoToX(*objEgo, *objX);
-                if (angle < -180.0) angle += 360.0;
-                if (angle > 180.0) angle -= 360.0;
-
-                xs.emplace_back(distance, angle);
-                xs.back().name = objX->getExternalId();
-                xs.back().radius = objX->getRadius().value();
-            }
+    const std::size_t numObjects = mObjects.size();
+    mSlotObjects.clear();
+    mHandleSlots.clear();
+    mCentreX.resize(numObjects);
+    mCentreY.resize(numObjects);
+    mPositionX.resize(numObjects);
+    mPositionY.resize(numObjects);
+    mRadius.resize(numObjects);
+    mRows.resize(numObjects); /*< rows keep their buffers across updates */
+
+    Slot slot = 0;
+    for (const auto& object : mObjects) {
+        mSlotObjects.push_back(object.get());
+        if (object->getHandle() >= mHandleSlots.size()) {
+            // handles without object are mapped to an invalid slot
+            mHandleSlots.resize(object->getHandle() + 1, numObjects);
         }
-
-        mMatrix.emplace(objEgo->getExternalId(), std::move(xs));
+        mHandleSlots[object->getHandle()] = slot;
+        mCentreX[slot] = object->getCentrePoint().x.value();
+        mCentreY[slot] = object->getCentrePoint().y.value();
+        mPositionX[slot] = object->getVehicleData().position().x.value();
+        mPositionY[slot] = object->getVehicleData().position().y.value();
+        mRadius[slot] = object->getRadius().value();
+        ++slot;
     }
+
+    // invalidate all rows at once
+    ++mGeneration;
 }
 
-std::vector<std::string> InterdistanceMatrix::select(const EnvironmentModelObject& ego, const SensorConfigRadar& config)
+std::vector<PreselectionMethod::Handle> InterdistanceMatrix::select(const EnvironmentModelObject& ego, const SensorConfigRadar& config)
 {
     assert(ego.getExternalId() == config.egoID);
     ItemSelector selector = buildItemSelector(config);
 
-    std::vector<std::string> objectsInVecinityID;
+    if (ego.getHandle() >= mHandleSlots.size() || mHandleSlots[ego.getHandle()] >= mSlotObjects.size()) {
+        throw std::runtime_error("No entry found for " + config.egoID);
+    }
+
+    const Slot egoSlot = mHandleSlots[ego.getHandle()];
+    const Row& row = getRow(egoSlot);
 
-    auto ego_found = mMatrix.find(config.egoID);
-    if (ego_found != mMatrix.end()) {
-        for (const auto& item : ego_found->second) {
-            if (checkItemSelector(selector, item)) {
-                objectsInVecinityID.push_back(item.name);
-            }
+    std::vector<Handle> objectsInVecinity;
+    for (Slot slot = 0; slot < mSlotObjects.size(); ++slot) {
+        // add radius because the center of the vehicle could be out of sensor range but parts of vehicle body still be within
+        if (slot != egoSlot && row.distance[slot] <= selector.range + mRadius[slot] &&
+                row.angle[slot] < selector.right && row.angle[slot] > selector.left) {
+            objectsInVecinity.push_back(mSlotObjects[slot]->getHandle());
         }
-    } else {
-        throw std::runtime_error("No entry found for " + config.egoID);
     }
 
-    return objectsInVecinityID;
+    return objectsInVecinity;
+}
+
+const InterdistanceMatrix::Row& InterdistanceMatrix::getRow(Slot slot)
+{
+    Row& row = mRows[slot];
+    if (row.generation != mGeneration) {
+        const std::size_t n = mSlotObjects.size();
+        row.distance.resize(n);
+        row.angle.resize(n);
+        computeDistances(mCentreX.data(), mCentreY.data(), mCentreX[slot], mCentreY[slot], row.distance.data(), n);
+        computeAngles(mPositionX.data(), mPositionY.data(), mPositionX[slot], mPositionY[slot],
+                calcReferenceAngle(*mSlotObjects[slot]), row.angle.data(), n);
+        row.generation = mGeneration;
+    }
+    return row;
 }
 
 InterdistanceMatrix::ItemSelector InterdistanceMatrix::buildItemSelector(const SensorConfigRadar& config) const
@@ -132,22 +160,7 @@ InterdistanceMatrix::ItemSelector InterdistanceMatrix::buildItemSelector(const S
     return selector;
 }
 
-bool InterdistanceMatrix::checkItemSelector(const ItemSelector& selector, const MatrixItem& item) const
-{
-    // add radius because the center of the vehicle could be out of sensor range but parts of vehicle body still be within
-    if (item.distanceToY <= selector.range + item.radius) {
-        return item.angleToY < selector.right && item.angleToY > selector.left;
-    }
-
-    return false;
-}
-
-double InterdistanceMatrix::calcDistanceEgoToX(const geometry::Point& egoPoint, const geometry::Point& otherPoint) const
-{
-    return geom::distance(egoPoint, otherPoint);
-}
-
-double InterdistanceMatrix::calcAngleEgoToX(const EnvironmentModelObject& objEgo, const EnvironmentModelObject& objX) const
+double InterdistanceMatrix::calcReferenceAngle(const EnvironmentModelObject& objEgo) const
 {
     geometry::Point reference(0.0, -1.0);
 
@@ -156,22 +169,8 @@ double InterdistanceMatrix::calcAngleEgoToX(const EnvironmentModelObject& objEgo
     geom::strategy::transform::rotate_transformer<geom::radian, double, 2, 2> rotate(-1.0 * egoData.heading() / boost::units::si::radian);
     geom::transform(reference, reference, rotate);
 
-    // Translate reference point to ego vehicle
-    geom::strategy::transform::translate_transformer<double, 2, 2> translate(egoData.position().x.value(), egoData.position().y.value());
-    geom::transform(reference, reference, translate);
-
-    // Determine angle between reference and objX (ego is vertex point)
-    geometry::Point objEgoPos, objXPos;
-    geom::convert(egoData.position(), objEgoPos);
-    geom::convert(objX.getVehicleData().position(), objXPos);
-    return createAngle(reference, objXPos, objEgoPos).degree();
-}
-
-InterdistanceMatrix::MatrixItem::MatrixItem(double distanceToY_, double angleToY_) :
-    distanceToY(distanceToY_), angleToY(angleToY_)
-{
-    relX = cos(angleToY) * distanceToY;
-    relY = sin(angleToY) * distanceToY;
+    // reference point is relative to ego vehicle, i.e. ego is vertex point
+    return std::atan2(reference.get<0>(), reference.get<1>());
 }
 
 } // namespace artery
@@ -9,8 +9,8 @@
 
 #include "artery/envmod/PreselectionMethod.h"
 #include "artery/envmod/Geometry.h"
-#include <list>
-#include <unordered_map>
+#include <cstddef>
+#include <vector>
 
 namespace artery
 {
@@ -21,6 +21,10 @@ class EnvironmentModelObject;
  * The distance to the middle of the object and the angle is checked.
  * Not as exact as the other methods because only the center of the object
  * will be checked, disregarding the vehicle frame.
+ *
+ * Object attributes are stored as structure of arrays indexed by dense object slots.
+ * Matrix rows (distances and bearings from one ego to all other objects) are built lazily,
+ * i.e. only for those egos actually querying the matrix since the last update.
  */
 class InterdistanceMatrix : public PreselectionMethod
 {
@@ -28,9 +32,11 @@ public:
     using PreselectionMethod::PreselectionMethod;
 
     void update() override;
-    std::vector<std::string> select(const EnvironmentModelObject& ego, const SensorConfigRadar&) override;
+    std::vector<Handle> select(const EnvironmentModelObject& ego, const SensorConfigRadar&) override;
 
 private:
+    using Slot = std::size_t;
+
     struct ItemSelector
     {
         double left = 0.0;
@@ -38,39 +44,38 @@ private:
         double range = 0.0;
     };
 
-    struct MatrixItem
+    struct Row
     {
-        MatrixItem(double distanceToY_, double angleToY_);
-
-        double distanceToY = 0.0;
-        double angleToY = 0.0;
-        double radius = 0.0;
-        double relX = 0.0;
-        double relY = 0.0;
-        std::string name;
+        std::vector<double> distance; /*< distance between centre points in meter */
+        std::vector<double> angle; /*< angle relative to ego's driving direction in degree */
+        unsigned generation = 0;
     };
 
     ItemSelector buildItemSelector(const SensorConfigRadar&) const;
-    bool checkItemSelector(const ItemSelector&, const MatrixItem&) const;
 
     /**
-     * Calculates distance between ego object and another object.
-     * @param egoPoint ego position
-     * @param otherPoint other object's position
-     * @return Euclidian distance in meter
+     * Get matrix row of given slot, (re-)build it if outdated
+     * @param slot ego object's slot
+     * @return up-to-date row
      */
-    double calcDistanceEgoToX(const geometry::Point& egoPoint, const geometry::Point& otherPoint) const;
+    const Row& getRow(Slot slot);
 
     /**
-     * Calculates angle between ego object and another object.
-     * The angle is calculated under consideration of the driving direction of the ego vehicle.
+     * Calculates the reference angle of an ego object's driving direction.
      * @param objEgo Ego object
-     * @param objX other object
-     * @return angle in degree
+     * @return angle in radian compatible to bearings of row items
      */
-    double calcAngleEgoToX(const EnvironmentModelObject& objEgo, const EnvironmentModelObject& objX) const;
+    double calcReferenceAngle(const EnvironmentModelObject& objEgo) const;
 
-    std::unordered_map<std::string, std::list<MatrixItem>> mMatrix;
+    std::vector<const EnvironmentModelObject*> mSlotObjects;
+    std::vector<Slot> mHandleSlots; /*< slot lookup by object handle */
+    std::vector<double> mCentreX;
+    std::vector<double> mCentreY;
+    std::vector<double> mPositionX;
+    std::vector<double> mPositionY;
+    std::vector<double> mRadius;
+    std::vector<Row> mRows;
+    unsigned mGeneration = 0;
 };
 
 } // namespace artery
@@ -8,10 +8,15 @@
 #include "artery/envmod/EnvironmentModelObject.h"
 #include "artery/envmod/LocalEnvironmentModel.h"
 #include "artery/envmod/GlobalEnvironmentModel.h"
+#include "artery/envmod/PerceptionSnapshot.h"
 #include "artery/envmod/sensor/Sensor.h"
 #include "artery/utility/FilterRules.h"
 #include <inet/common/ModuleAccess.h>
 #include <omnetpp/cxmlelement.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
 #include <utility>
 
 using namespace omnetpp;
@@ -21,8 +26,17 @@ namespace artery
 
 Define_Module(LocalEnvironmentModel)
 
+static_assert(std::is_same<LocalEnvironmentModel::ObjectHandle, EnvironmentModelObject::Handle>::value, "ObjectHandle mismatch");
+
 static const simsignal_t EnvironmentModelRefreshSignal = cComponent::registerSignal("EnvironmentModel.refresh");
 
+namespace {
+
+const std::size_t noSlot = std::numeric_limits<std::size_t>::max();
+const std::size_t expiryWheelSize = 256;
+
+} // namespace
+
 LocalEnvironmentModel::LocalEnvironmentModel() :
     mGlobalEnvironmentModel(nullptr)
 {
@@ -38,12 +52,20 @@ void LocalEnvironmentModel::initialize(int stage)
     if (stage == 0) {
         mGlobalEnvironmentModel = inet::getModuleFromPar<GlobalEnvironmentModel>(par("globalEnvironmentModule"), this);
         mGlobalEnvironmentModel->subscribe(EnvironmentModelRefreshSignal, this);
+        mObjectRemovals = mGlobalEnvironmentModel->getObjectRemovals();
 
         auto vehicle = inet::findContainingNode(this);
         mMiddleware = inet::getModuleFromPar<Middleware>(par("middlewareModule"), vehicle);
         Facilities& fac = mMiddleware->getFacilities();
         fac.register_mutable(mGlobalEnvironmentModel);
         fac.register_mutable(this);
+
+        mExpiryResolution = par("expiryResolution");
+        if (mExpiryResolution <= SimTime::ZERO) {
+            throw cRuntimeError("expiryResolution has to be positive");
+        }
+        mExpiryWheel.resize(expiryWheelSize);
+        mExpiryTick = getExpiryTick(simTime());
     } else if (stage == 1) {
         initializeSensors();
     }
@@ -53,46 +75,226 @@ void LocalEnvironmentModel::finish()
 {
     mGlobalEnvironmentModel->unsubscribe(EnvironmentModelRefreshSignal, this);
     mObjects.clear();
+    mSlotHandles.clear();
+    mObjectSlots.clear();
+    mFirstSeen.clear();
+    mLastSeen.clear();
+    mSnapshot.reset();
+    for (auto& bucket : mExpiryWheel) {
+        bucket.clear();
+    }
 }
 
 void LocalEnvironmentModel::receiveSignal(cComponent*, simsignal_t signal, cObject* obj, cObject*)
 {
     if (signal == EnvironmentModelRefreshSignal) {
-        for (auto* sensor : mSensors) {
-            sensor->measurement();
+        for (std::size_t i = 0; i < mSensors.size(); ++i) {
+            if (isMeasurementDue(i)) {
+                mSensors[i]->measurement();
+
+                MeasurementSchedule& schedule = mSchedules[i];
+                while (schedule.interval > SimTime::ZERO && schedule.next <= simTime()) {
+                    schedule.next += schedule.interval;
+                }
+            }
         }
         update();
     }
 }
 
+bool LocalEnvironmentModel::isMeasurementDue(const Sensor& sensor) const
+{
+    return isMeasurementDue(getSensorIndex(sensor));
+}
+
+bool LocalEnvironmentModel::isMeasurementDue(std::size_t sensor) const
+{
+    const MeasurementSchedule& schedule = mSchedules[sensor];
+    return schedule.interval == SimTime::ZERO || schedule.next <= simTime();
+}
+
 void LocalEnvironmentModel::complementObjects(const SensorDetection& detection, const Sensor& sensor)
 {
+   const std::size_t sensorIndex = getSensorIndex(sensor);
+   mSnapshot.reset();
    for (auto& detectedObject : detection.objects) {
-      auto foundObject = mObjects.find(detectedObject);
-      if (foundObject != mObjects.end()) {
-         Tracking& tracking = foundObject->second;
-         tracking.tap(&sensor);
-      } else {
-         mObjects.emplace(detectedObject, Tracking { ++mTrackingCounter, &sensor });
+      const ObjectHandle handle = detectedObject->getHandle();
+      if (handle >= mObjectSlots.size()) {
+         mObjectSlots.resize(handle + 1, noSlot);
       }
+
+      std::size_t slot = mObjectSlots[handle];
+      if (slot != noSlot) {
+         std::owner_less<Object> less;
+         const Object& tracked = mObjects[slot].first;
+         if (less(tracked, detectedObject) || less(detectedObject, tracked)) {
+            // handle has been re-used, i.e. tracked object has been removed globally in the meantime
+            eraseObject(slot);
+            slot = noSlot;
+         }
+      }
+
+      if (slot == noSlot) {
+         slot = mObjects.size();
+         mObjects.emplace_back(detectedObject, Tracking { ++mTrackingCounter, this, handle });
+         mSlotHandles.push_back(handle);
+         mObjectSlots[handle] = slot;
+         mFirstSeen.resize(mFirstSeen.size() + mSensors.size());
+         mLastSeen.resize(mLastSeen.size() + mSensors.size());
+      }
+
+      tap(slot, sensorIndex);
    }
 }
 
 void LocalEnvironmentModel::update()
 {
-    for (auto it = mObjects.begin(); it != mObjects.end();) {
-        const Object& object = it->first;
-        Tracking& tracking = it->second;
-        tracking.update();
+    mSnapshot.reset();
+    eraseRemovedObjects();
+
+    // visit all wheel buckets due since last update, but each bucket at most once
+    const std::int64_t nowTick = getExpiryTick(simTime());
+    const std::int64_t lastTick = std::min<std::int64_t>(nowTick, mExpiryTick + expiryWheelSize - 1);
+    for (std::int64_t tick = mExpiryTick; tick <= lastTick; ++tick) {
+        auto& bucket = mExpiryWheel[tick % expiryWheelSize];
+        for (std::size_t i = 0; i < bucket.size();) {
+            if (getExpiryTick(bucket[i].deadline) > nowTick) {
+                // entry belongs to a later round of the wheel
+                ++i;
+                continue;
+            }
+
+            if (processExpiry(bucket[i])) {
+                mExpiryPending.push_back(bucket[i]);
+            }
+            bucket[i] = bucket.back();
+            bucket.pop_back();
+        }
+    }
+
+    // current bucket is visited again at next update because its entries may expire within this tick
+    mExpiryTick = nowTick;
+
+    for (const Expiry& expiry : mExpiryPending) {
+        scheduleExpiry(expiry);
+    }
+    mExpiryPending.clear();
+}
+
+std::shared_ptr<const PerceptionSnapshot> LocalEnvironmentModel::getSnapshot() const
+{
+    if (!mSnapshot) {
+        const std::size_t numSensors = mSensors.size();
+        auto snapshot = std::make_shared<PerceptionSnapshot>(simTime(),
+                std::vector<const Sensor*>(mSensors.begin(), mSensors.end()));
+        for (std::size_t slot = 0; slot < mObjects.size(); ++slot) {
+            const TrackedObject& object = mObjects[slot];
+            PerceptionSnapshot::Entry entry { object.first, object.second.id(), object.second.mSensorMask };
+            snapshot->add(entry, mLastSeen.data() + slot * numSensors);
+        }
+        mSnapshot = std::move(snapshot);
+    }
+    return mSnapshot;
+}
+
+void LocalEnvironmentModel::tap(std::size_t slot, std::size_t sensor)
+{
+    const std::size_t cell = slot * mSensors.size() + sensor;
+    Tracking& tracking = mObjects[slot].second;
+    const std::uint64_t bit = std::uint64_t(1) << sensor;
+    mLastSeen[cell] = simTime();
+
+    if (!(tracking.mSensorMask & bit)) {
+        tracking.mSensorMask |= bit;
+        mFirstSeen[cell] = simTime();
+
+        // a single wheel entry per tracking sensor, it is re-scheduled as long as tracking continues
+        Expiry expiry;
+        expiry.handle = mSlotHandles[slot];
+        expiry.tracking = tracking.id();
+        expiry.sensor = sensor;
+        expiry.deadline = simTime() + mSensors[sensor]->getValidityPeriod();
+        scheduleExpiry(expiry);
+    }
+}
+
+bool LocalEnvironmentModel::processExpiry(Expiry& expiry)
+{
+    const std::size_t slot = expiry.handle < mObjectSlots.size() ? mObjectSlots[expiry.handle] : noSlot;
+    if (slot == noSlot || mObjects[slot].second.id() != expiry.tracking) {
+        // tracking has been erased already
+        return false;
+    }
+
+    Tracking& tracking = mObjects[slot].second;
+    const std::uint64_t bit = std::uint64_t(1) << expiry.sensor;
+    const SimTime deadline = mLastSeen[slot * mSensors.size() + expiry.sensor] + mSensors[expiry.sensor]->getValidityPeriod();
+    if (deadline < simTime()) {
+        tracking.mSensorMask &= ~bit;
+        if (tracking.expired()) {
+            eraseObject(slot);
+        }
+        return false;
+    } else {
+        expiry.deadline = deadline;
+        return true;
+    }
+}
+
+void LocalEnvironmentModel::scheduleExpiry(const Expiry& expiry)
+{
+    mExpiryWheel[getExpiryTick(expiry.deadline) % expiryWheelSize].push_back(expiry);
+}
 
-        if (object.expired() || tracking.expired()) {
-            it = mObjects.erase(it);
-        } else {
-            ++it;
+std::int64_t LocalEnvironmentModel::getExpiryTick(SimTime time) const
+{
+    return static_cast<std::int64_t>(std::floor(time / mExpiryResolution));
+}
+
+void LocalEnvironmentModel::eraseObject(std::size_t slot)
+{
+    const std::size_t last = mObjects.size() - 1;
+    const std::size_t numSensors = mSensors.size();
+    mObjectSlots[mSlotHandles[slot]] = noSlot;
+
+    // keep tables contiguous: move last object into vacant slot
+    if (slot != last) {
+        mObjects[slot] = std::move(mObjects[last]);
+        mSlotHandles[slot] = mSlotHandles[last];
+        mObjectSlots[mSlotHandles[slot]] = slot;
+        std::copy_n(mFirstSeen.begin() + last * numSensors, numSensors, mFirstSeen.begin() + slot * numSensors);
+        std::copy_n(mLastSeen.begin() + last * numSensors, numSensors, mLastSeen.begin() + slot * numSensors);
+    }
+
+    mObjects.pop_back();
+    mSlotHandles.pop_back();
+    mFirstSeen.resize(mFirstSeen.size() - numSensors);
+    mLastSeen.resize(mLastSeen.size() - numSensors);
+}
+
+void LocalEnvironmentModel::eraseRemovedObjects()
+{
+    // scanning for objects removed from the global model is only necessary if any has been removed
+    const unsigned long removals = mGlobalEnvironmentModel->getObjectRemovals();
+    if (removals != mObjectRemovals) {
+        mObjectRemovals = removals;
+        for (std::size_t slot = mObjects.size(); slot > 0; --slot) {
+            if (mObjects[slot - 1].first.expired()) {
+                eraseObject(slot - 1);
+            }
         }
     }
 }
 
+std::size_t LocalEnvironmentModel::getSensorIndex(const Sensor& sensor) const
+{
+    auto found = std::find(mSensors.begin(), mSensors.end(), &sensor);
+    if (found == mSensors.end()) {
+        throw cRuntimeError("sensor %s is not attached to this local environment model", sensor.getFullPath().c_str());
+    }
+    return std::distance(mSensors.begin(), found);
+}
+
 void LocalEnvironmentModel::initializeSensors()
 {
     cXMLElement* config = par("sensors").xmlValue();
@@ -107,6 +309,11 @@ void LocalEnvironmentModel::initializeSensors()
         }
 
         if (sensor_applicable) {
+            // trackings, snapshots and CPMs refer to sensors by bits of 64 bit masks
+            if (mSensors.size() >= 64) {
+                throw cRuntimeError("too many sensors, tracking is limited to 64 sensors per local environment model");
+            }
+
             cModuleType* module_type = cModuleType::get(sensor_cfg->getAttribute("type"));
             const char* sensor_name = sensor_cfg->getAttribute("name");
             if (!sensor_name || !*sensor_name) {
@@ -123,57 +330,85 @@ void LocalEnvironmentModel::initializeSensors()
                 throw cRuntimeError("%s is not of type Sensor", module_type->getFullName());
             }
 
+            MeasurementSchedule schedule;
+            const char* interval = sensor_cfg->getAttribute("interval");
+            if (interval && *interval) {
+                schedule.interval = SimTime::parse(interval);
+                if (schedule.interval < SimTime::ZERO) {
+                    throw cRuntimeError("negative measurement interval of sensor %s", sensor->getFullName());
+                } else if (schedule.interval > sensor->getValidityPeriod()) {
+                    EV_WARN << "measurement interval of sensor " << sensor->getFullName()
+                        << " exceeds its validity period, tracking is interrupted between measurements\n";
+                }
+                // stagger periodic measurements of all sensors across their interval
+                schedule.next = simTime() + schedule.interval * mGlobalEnvironmentModel->getMeasurementPhase();
+            }
+
             mSensors.push_back(sensor);
+            mSchedules.push_back(schedule);
         }
     }
 }
 
 
-LocalEnvironmentModel::Tracking::Tracking(int id, const Sensor* sensor) : mId(id)
+LocalEnvironmentModel::Tracking::Tracking(int id, const LocalEnvironmentModel* model, ObjectHandle handle) :
+    mId(id), mModel(model), mHandle(handle)
 {
-    mSensors.emplace(sensor, TrackingTime {});
 }
 
-bool LocalEnvironmentModel::Tracking::expired() const
+std::size_t LocalEnvironmentModel::Tracking::row() const
 {
-    return mSensors.empty();
+    const auto& slots = mModel->mObjectSlots;
+    const std::size_t slot = mHandle < slots.size() ? slots[mHandle] : noSlot;
+    return slot != noSlot && mModel->mObjects[slot].second.mId == mId ? slot : noSlot;
 }
 
-void LocalEnvironmentModel::Tracking::update()
+LocalEnvironmentModel::Tracking::SensorRange LocalEnvironmentModel::Tracking::sensors() const
 {
-    for (auto it = mSensors.begin(); it != mSensors.end();) {
-      const Sensor* sensor = it->first;
-      const TrackingTime& tracking = it->second;
-
-      const bool expired = tracking.last() + sensor->getValidityPeriod() < simTime();
-      if (expired) {
-          it = mSensors.erase(it);
-      } else {
-          ++it;
-      }
+    // copies of erased trackings yield no sensors, others refer to the model's current tracking
+    const std::size_t slot = row();
+    if (slot == noSlot) {
+        return SensorRange {};
     }
+
+    const Tracking* tracking = &mModel->mObjects[slot].second;
+    return SensorRange { SensorIterator { tracking, 0 }, SensorIterator { tracking, mModel->mSensors.size() } };
 }
 
-void LocalEnvironmentModel::Tracking::tap(const Sensor* sensor)
+LocalEnvironmentModel::Tracking::SensorIterator::SensorIterator(const Tracking* tracking, std::size_t sensor) :
+    mTracking(tracking), mSensor(sensor)
 {
-    auto found = mSensors.find(sensor);
-    if (found != mSensors.end()) {
-         TrackingTime& tracking = found->second;
-         tracking.tap();
-    } else {
-         mSensors.emplace(sensor, TrackingTime {});
+    // skip leading sensors not tracking the object
+    const std::size_t numSensors = mTracking->mModel->mSensors.size();
+    if (mSensor < numSensors && !(mTracking->mSensorMask & (std::uint64_t(1) << mSensor))) {
+        increment();
     }
 }
 
+LocalEnvironmentModel::Tracking::SensorTracking LocalEnvironmentModel::Tracking::SensorIterator::dereference() const
+{
+    const LocalEnvironmentModel* model = mTracking->mModel;
+    const std::size_t cell = mTracking->row() * model->mSensors.size() + mSensor;
+    return SensorTracking { model->mSensors[mSensor], TrackingTime { model->mFirstSeen[cell], model->mLastSeen[cell] } };
+}
 
-LocalEnvironmentModel::TrackingTime::TrackingTime() :
-   mFirst(simTime()), mLast(simTime())
+bool LocalEnvironmentModel::Tracking::SensorIterator::equal(const SensorIterator& other) const
 {
+    return mTracking == other.mTracking && mSensor == other.mSensor;
 }
 
-void LocalEnvironmentModel::TrackingTime::tap()
+void LocalEnvironmentModel::Tracking::SensorIterator::increment()
+{
+    const std::size_t numSensors = mTracking->mModel->mSensors.size();
+    do {
+        ++mSensor;
+    } while (mSensor < numSensors && !(mTracking->mSensorMask & (std::uint64_t(1) << mSensor)));
+}
+
+
+LocalEnvironmentModel::TrackingTime::TrackingTime(SimTime first, SimTime last) :
+   mFirst(first), mLast(last)
 {
-    mLast = simTime();
 }
 
 
@@ -183,7 +418,7 @@ TrackedObjectsFilterRange filterBySensorCategory(const LocalEnvironmentModel::Tr
     TrackedObjectsFilterPredicate seenByCategory = [category](const LocalEnvironmentModel::TrackedObject& obj) {
         const auto& detections = obj.second.sensors();
         return std::any_of(detections.begin(), detections.end(),
-                [&category](const LocalEnvironmentModel::Tracking::TrackingMap::value_type& tracking) {
+                [&category](const LocalEnvironmentModel::Tracking::SensorTracking& tracking) {
                     const Sensor* sensor = tracking.first;
                     return sensor->getSensorCategory() == category;
                 });
@@ -8,13 +8,15 @@
 #define LOCALENVIRONMENTMODEL_H_
 
 #include <boost/iterator/filter_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
 #include <boost/range/iterator_range.hpp>
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
 #include <omnetpp/simtime.h>
+#include <cstdint>
 #include <functional>
-#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace artery
@@ -23,6 +25,7 @@ namespace artery
 class EnvironmentModelObject;
 class GlobalEnvironmentModel;
 class Middleware;
+class PerceptionSnapshot;
 class Sensor;
 class SensorDetection;
 
@@ -36,12 +39,12 @@ class LocalEnvironmentModel : public omnetpp::cSimpleModule, public omnetpp::cLi
 {
 public:
     using Object = std::weak_ptr<EnvironmentModelObject>;
+    using ObjectHandle = std::uint32_t; /*< EnvironmentModelObject::Handle */
 
     class TrackingTime
     {
     public:
-        TrackingTime();
-        void tap();
+        TrackingTime(omnetpp::SimTime first, omnetpp::SimTime last);
 
         omnetpp::SimTime first() const { return mFirst; }
         omnetpp::SimTime last() const { return mLast; }
@@ -51,27 +54,61 @@ public:
         omnetpp::SimTime mLast;
     };
 
+    /**
+     * Tracking of an object by local sensors
+     *
+     * Sensors currently tracking the object are stored as bitmask,
+     * their tracking times are kept by the LocalEnvironmentModel in contiguous tables.
+     */
     class Tracking
     {
     public:
-        using TrackingMap = std::map<const Sensor*, TrackingTime>;
+        using SensorTracking = std::pair<const Sensor*, TrackingTime>;
+
+        class SensorIterator : public boost::iterator_facade<
+            SensorIterator, SensorTracking, boost::forward_traversal_tag, SensorTracking>
+        {
+        public:
+            SensorIterator() = default;
+            SensorIterator(const Tracking*, std::size_t sensor);
+
+        private:
+            friend class boost::iterator_core_access;
+            SensorTracking dereference() const;
+            bool equal(const SensorIterator&) const;
+            void increment();
+
+            const Tracking* mTracking = nullptr;
+            std::size_t mSensor = 0;
+        };
 
-        Tracking(int id, const Sensor* sensor);
+        using SensorRange = boost::iterator_range<SensorIterator>;
 
-        bool expired() const;
-        void update();
-        void tap(const Sensor*);
+        Tracking(int id, const LocalEnvironmentModel*, ObjectHandle);
 
+        bool expired() const { return mSensorMask == 0; }
         int id() const { return mId; }
-        const TrackingMap& sensors() const { return mSensors; }
+        SensorRange sensors() const;
 
     private:
+        friend class LocalEnvironmentModel;
+
+        /**
+         * Resolve row in model's tracking time tables
+         *
+         * Rows are moved when other trackings are erased, thus they are looked up via the object handle.
+         * @return row of this tracking or noSlot if it has been erased meanwhile
+         */
+        std::size_t row() const;
+
         int mId;
-        TrackingMap mSensors;
+        std::uint64_t mSensorMask = 0; /*< bit i is set if sensor i is tracking */
+        const LocalEnvironmentModel* mModel;
+        ObjectHandle mHandle;
     };
 
-    using TrackedObjects = std::map<Object, Tracking, std::owner_less<Object>>;
-    using TrackedObject = typename TrackedObjects::value_type;
+    using TrackedObject = std::pair<Object, Tracking>;
+    using TrackedObjects = std::vector<TrackedObject>;
 
 
     LocalEnvironmentModel();
@@ -97,11 +134,27 @@ public:
      */
     void complementObjects(const SensorDetection&, const Sensor&);
 
+    /**
+     * Check if a sensor is due for measurement at the current refresh
+     * @param sensor local sensor
+     * @return true if sensor measures at current refresh
+     */
+    bool isMeasurementDue(const Sensor&) const;
+
     /**
      * Get all currently seen objects by any local sensor
      */
     const TrackedObjects& allObjects() const { return mObjects; }
 
+    /**
+     * Get snapshot of currently tracked objects
+     *
+     * The snapshot is created on first request after a change and shared by all requesters afterwards.
+     * It remains valid (but outdated) when the local model changes.
+     * @return immutable snapshot
+     */
+    std::shared_ptr<const PerceptionSnapshot> getSnapshot() const;
+
     /**
      * Get local sensors
      *
@@ -110,13 +163,46 @@ public:
     const std::vector<Sensor*>& getSensors() const { return mSensors; }
 
 private:
+    struct Expiry
+    {
+        ObjectHandle handle;
+        int tracking; /*< tracking id, detects stale entries of re-used handles */
+        std::size_t sensor;
+        omnetpp::SimTime deadline;
+    };
+
+    struct MeasurementSchedule
+    {
+        omnetpp::SimTime interval; /*< zero if sensor measures at each refresh */
+        omnetpp::SimTime next;
+    };
+
     void initializeSensors();
+    bool isMeasurementDue(std::size_t sensor) const;
+    std::size_t getSensorIndex(const Sensor&) const;
+    void tap(std::size_t slot, std::size_t sensor);
+    void eraseObject(std::size_t slot);
+    void eraseRemovedObjects();
+    void scheduleExpiry(const Expiry&);
+    bool processExpiry(Expiry&);
+    std::int64_t getExpiryTick(omnetpp::SimTime) const;
 
     Middleware* mMiddleware;
     GlobalEnvironmentModel* mGlobalEnvironmentModel;
     int mTrackingCounter = 0;
     TrackedObjects mObjects;
+    std::vector<ObjectHandle> mSlotHandles; /*< object handles in order of mObjects */
+    std::vector<std::size_t> mObjectSlots; /*< slots in mObjects indexed by object handle */
+    std::vector<omnetpp::SimTime> mFirstSeen; /*< row per tracked object, column per sensor */
+    std::vector<omnetpp::SimTime> mLastSeen; /*< same layout as mFirstSeen */
     std::vector<Sensor*> mSensors;
+    std::vector<MeasurementSchedule> mSchedules; /*< same order as mSensors */
+    std::vector<std::vector<Expiry>> mExpiryWheel;
+    std::vector<Expiry> mExpiryPending;
+    omnetpp::SimTime mExpiryResolution;
+    std::int64_t mExpiryTick = 0;
+    unsigned long mObjectRemovals = 0;
+    mutable std::shared_ptr<const PerceptionSnapshot> mSnapshot; /*< reset whenever trackings change */
 };
 
 using TrackedObjectsFilterPredicate = std::function<bool(const LocalEnvironmentModel::TrackedObject&)>;
@@ -0,0 +1,182 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/envmod/ObstacleEdgeIndex.h"
+#include <boost/geometry/algorithms/intersects.hpp>
+#include <boost/geometry/geometries/register/linestring.hpp>
+#include <omnetpp/cexception.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using ObstacleEdge = std::array<artery::Position, 2>;
+BOOST_GEOMETRY_REGISTER_LINESTRING(ObstacleEdge)
+
+namespace artery
+{
+
+namespace {
+
+// cells are enlarged by this margin, i.e. rounding errors do not hide intersections at cell borders
+const double cellMargin = 1e-6;
+
+// upper bound of grid cells, cell size is enlarged for vast areas
+const std::size_t maxCells = 1 << 22;
+
+} // namespace
+
+ObstacleEdgeIndex::ObstacleEdgeIndex(double cellSize) :
+    mConfiguredCellSize(cellSize), mCellSize(cellSize)
+{
+    if (mConfiguredCellSize <= 0.0) {
+        throw omnetpp::cRuntimeError("obstacle edge grid cell size has to be positive");
+    }
+}
+
+void ObstacleEdgeIndex::add(const std::vector<Position>& outline)
+{
+    if (outline.size() < 2) {
+        return;
+    }
+
+    for (std::size_t i = 0; i + 1 < outline.size(); ++i) {
+        mEdges.push_back(Segment {{ outline[i], outline[i + 1] }});
+    }
+    if (outline.front() != outline.back()) {
+        mEdges.push_back(Segment {{ outline.back(), outline.front() }});
+    }
+}
+
+void ObstacleEdgeIndex::build()
+{
+    mCellOffsets.clear();
+    mCellEdges.clear();
+    mCellsX = 0;
+    mCellsY = 0;
+    mCellSize = mConfiguredCellSize;
+    if (mEdges.empty()) {
+        return;
+    }
+
+    double minX = std::numeric_limits<double>::max();
+    double minY = std::numeric_limits<double>::max();
+    double maxX = std::numeric_limits<double>::lowest();
+    double maxY = std::numeric_limits<double>::lowest();
+    for (const Segment& edge : mEdges) {
+        for (const Position& point : edge) {
+            minX = std::min(minX, point.x.value());
+            minY = std::min(minY, point.y.value());
+            maxX = std::max(maxX, point.x.value());
+            maxY = std::max(maxY, point.y.value());
+        }
+    }
+
+    mOriginX = minX;
+    mOriginY = minY;
+    auto cells = [this](double extent) { return static_cast<std::size_t>(std::floor(extent / mCellSize)) + 1; };
+    while (cells(maxX - minX) * cells(maxY - minY) > maxCells) {
+        mCellSize *= 2.0;
+    }
+    mCellsX = cells(maxX - minX);
+    mCellsY = cells(maxY - minY);
+
+    // compressed cell storage: count edges per cell first, then fill cells
+    mCellOffsets.assign(mCellsX * mCellsY + 1, 0);
+    for (const Segment& edge : mEdges) {
+        forEachCell(edge[0], edge[1], [this](std::size_t cell) { ++mCellOffsets[cell + 1]; });
+    }
+    for (std::size_t cell = 0; cell + 1 < mCellOffsets.size(); ++cell) {
+        mCellOffsets[cell + 1] += mCellOffsets[cell];
+    }
+
+    std::vector<std::size_t> fill(mCellOffsets.begin(), mCellOffsets.end() - 1);
+    mCellEdges.resize(mCellOffsets.back());
+    for (std::size_t i = 0; i < mEdges.size(); ++i) {
+        forEachCell(mEdges[i][0], mEdges[i][1], [&](std::size_t cell) { mCellEdges[fill[cell]++] = i; });
+    }
+}
+
+void ObstacleEdgeIndex::clear()
+{
+    mEdges.clear();
+    mCellOffsets.clear();
+    mCellEdges.clear();
+    mCellsX = 0;
+    mCellsY = 0;
+}
+
+bool ObstacleEdgeIndex::intersects(const Position& a, const Position& b) const
+{
+    if (mCellOffsets.empty()) {
+        return false;
+    }
+
+    const Segment segment {{ a, b }};
+    bool hit = false;
+    // edges spanning several cells might be tested repeatedly, which is cheaper than bookkeeping
+    forEachCell(a, b, [&](std::size_t cell) {
+            for (std::size_t i = mCellOffsets[cell]; !hit && i < mCellOffsets[cell + 1]; ++i) {
+                hit = boost::geometry::intersects(segment, mEdges[mCellEdges[i]]);
+            }
+        });
+    return hit;
+}
+
+void ObstacleEdgeIndex::forEachCell(const Position& a, const Position& b, const std::function<void(std::size_t)>& fn) const
+{
+    double ax = a.x.value(), ay = a.y.value();
+    double bx = b.x.value(), by = b.y.value();
+    if (ax > bx) {
+        std::swap(ax, bx);
+        std::swap(ay, by);
+    }
+
+    // segment is entirely outside of grid
+    const double gridMaxX = mOriginX + mCellsX * mCellSize;
+    const double gridMaxY = mOriginY + mCellsY * mCellSize;
+    if (bx < mOriginX - cellMargin || ax > gridMaxX + cellMargin ||
+            std::max(ay, by) < mOriginY - cellMargin || std::min(ay, by) > gridMaxY + cellMargin) {
+        return;
+    }
+
+    // visit column by column: y range of segment within each column determines its rows
+    const double dx = bx - ax;
+    const std::size_t firstColumn = getCellIndex(ax - cellMargin, mOriginX, mCellsX);
+    const std::size_t lastColumn = getCellIndex(bx + cellMargin, mOriginX, mCellsX);
+    for (std::size_t column = firstColumn; column <= lastColumn; ++column) {
+        const double x0 = std::max(ax, mOriginX + column * mCellSize - cellMargin);
+        const double x1 = std::min(bx, mOriginX + (column + 1) * mCellSize + cellMargin);
+
+        double y0 = ay, y1 = by;
+        if (dx > 0.0) {
+            const double slope = (by - ay) / dx;
+            y0 = ay + slope * (x0 - ax);
+            y1 = ay + slope * (x1 - ax);
+        }
+        if (y0 > y1) {
+            std::swap(y0, y1);
+        }
+
+        const std::size_t firstRow = getCellIndex(y0 - cellMargin, mOriginY, mCellsY);
+        const std::size_t lastRow = getCellIndex(y1 + cellMargin, mOriginY, mCellsY);
+        for (std::size_t row = firstRow; row <= lastRow; ++row) {
+            fn(row * mCellsX + column);
+        }
+    }
+}
+
+std::size_t ObstacleEdgeIndex::getCellIndex(double coord, double origin, std::size_t cells) const
+{
+    const double index = std::floor((coord - origin) / mCellSize);
+    if (index <= 0.0) {
+        return 0;
+    } else if (index >= cells - 1) {
+        return cells - 1;
+    } else {
+        return static_cast<std::size_t>(index);
+    }
+}
+
+} // namespace artery
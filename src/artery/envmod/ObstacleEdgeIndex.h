@@ -0,0 +1,81 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_ENVMOD_OBSTACLEEDGEINDEX_H_P4WD9NRA
+#define ARTERY_ENVMOD_OBSTACLEEDGEINDEX_H_P4WD9NRA
+
+#include "artery/utility/Geometry.h"
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * ObstacleEdgeIndex stores the edges of static obstacles in a uniform grid
+ *
+ * Each grid cell lists all edges passing through it. A line of sight is tested only against
+ * the edges of those cells it passes through instead of complete obstacle polygons.
+ * Cells are assigned conservatively, i.e. edges and lines of sight meeting at a cell border
+ * share at least one cell. Queries do not modify the index and are thus thread-safe.
+ */
+class ObstacleEdgeIndex
+{
+public:
+    /**
+     * @param cellSize edge length of grid cells in meters
+     */
+    explicit ObstacleEdgeIndex(double cellSize);
+
+    /**
+     * Add all edges of an obstacle
+     * @param outline obstacle polygon (open or closed)
+     */
+    void add(const std::vector<Position>& outline);
+
+    /**
+     * Build grid after all obstacles have been added
+     */
+    void build();
+
+    /**
+     * Remove all edges
+     */
+    void clear();
+
+    /**
+     * Check if any obstacle edge intersects the segment between a and b
+     *
+     * Only boundaries are tested: segments lying completely inside an obstacle are not reported.
+     * @param a start of segment
+     * @param b end of segment
+     * @return true if segment intersects (or touches) an edge
+     */
+    bool intersects(const Position& a, const Position& b) const;
+
+    std::size_t size() const { return mEdges.size(); }
+
+private:
+    using Segment = std::array<Position, 2>;
+
+    void forEachCell(const Position& a, const Position& b, const std::function<void(std::size_t)>&) const;
+    std::size_t getCellIndex(double coord, double origin, std::size_t cells) const;
+
+    double mConfiguredCellSize;
+    double mCellSize; /*< effective cell size of current grid */
+    double mOriginX = 0.0;
+    double mOriginY = 0.0;
+    std::size_t mCellsX = 0;
+    std::size_t mCellsY = 0;
+    std::vector<Segment> mEdges;
+    std::vector<std::size_t> mCellOffsets; /*< edges of cell i are at mCellEdges[mCellOffsets[i]] to mCellEdges[mCellOffsets[i + 1]] */
+    std::vector<std::size_t> mCellEdges;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_ENVMOD_OBSTACLEEDGEINDEX_H_P4WD9NRA */
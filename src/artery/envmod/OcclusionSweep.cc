@@ -0,0 +1,187 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/envmod/OcclusionSweep.h"
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/math/constants/constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace artery
+{
+
+namespace {
+
+using boost::math::double_constants::pi;
+using boost::math::double_constants::two_pi;
+
+// tolerances only enlarge the candidate sets, i.e. they never hide an actual occluder
+const double angleTolerance = 1e-6;
+const double distanceTolerance = 1e-6;
+
+} // namespace
+
+OcclusionSweep::OcclusionSweep(const Position& origin, unsigned bins) :
+    mOriginX(origin.x.value()), mOriginY(origin.y.value()),
+    mNumBins(std::max(bins, 1u)), mBinWidth(two_pi / mNumBins)
+{
+}
+
+OcclusionSweep::Occluder OcclusionSweep::add(const std::vector<Position>& outline)
+{
+    const Occluder occluder = mNumOccluders++;
+
+    const Position origin { mOriginX, mOriginY };
+    if (outline.size() >= 3 && boost::geometry::covered_by(origin, outline)) {
+        // every line of sight starts within this occluder
+        mUnbounded.push_back(occluder);
+    } else {
+        for (std::size_t i = 0; i < outline.size(); ++i) {
+            addEdge(occluder, outline[i], outline[(i + 1) % outline.size()]);
+        }
+    }
+
+    return occluder;
+}
+
+void OcclusionSweep::addEdge(Occluder occluder, const Position& a, const Position& b)
+{
+    const double ax = a.x.value() - mOriginX;
+    const double ay = a.y.value() - mOriginY;
+    const double bx = b.x.value() - mOriginX;
+    const double by = b.y.value() - mOriginY;
+
+    // closest point of edge to origin
+    const double dx = bx - ax;
+    const double dy = by - ay;
+    const double length2 = dx * dx + dy * dy;
+    const double t = length2 > 0.0 ? std::min(std::max(-(ax * dx + ay * dy) / length2, 0.0), 1.0) : 0.0;
+    const double distance = std::hypot(ax + t * dx, ay + t * dy);
+
+    if (distance < distanceTolerance) {
+        // edge touches origin and thus any line of sight
+        mUnbounded.push_back(occluder);
+        return;
+    }
+
+    Edge edge;
+    edge.occluder = occluder;
+    edge.distance = distance;
+    edge.start = bearing(ax, ay);
+    edge.span = bearing(bx, by) - edge.start;
+    if (edge.span > pi) {
+        edge.span -= two_pi;
+    } else if (edge.span < -pi) {
+        edge.span += two_pi;
+    }
+    if (edge.span < 0.0) {
+        edge.start = bearing(bx, by);
+        edge.span = -edge.span;
+    }
+    mEdges.push_back(edge);
+}
+
+void OcclusionSweep::build()
+{
+    auto forEachBin = [this](const Edge& edge, const std::function<void(unsigned)>& fn) {
+            double first = edge.start - angleTolerance;
+            if (first < 0.0) {
+                first += two_pi;
+            }
+            double last = edge.start + edge.span + angleTolerance;
+            if (last >= two_pi) {
+                last -= two_pi;
+            }
+
+            const unsigned lastBin = bin(last);
+            for (unsigned b = bin(first); b != lastBin; b = (b + 1) % mNumBins) {
+                fn(b);
+            }
+            fn(lastBin);
+        };
+
+    // compressed bin storage: edges of bin i are at mBinEdges[mBinOffsets[i]] to mBinEdges[mBinOffsets[i + 1]]
+    mBinOffsets.assign(mNumBins + 1, 0);
+    for (const Edge& edge : mEdges) {
+        forEachBin(edge, [this](unsigned b) { ++mBinOffsets[b + 1]; });
+    }
+    for (unsigned b = 0; b < mNumBins; ++b) {
+        mBinOffsets[b + 1] += mBinOffsets[b];
+    }
+
+    std::vector<std::size_t> fill(mBinOffsets.begin(), mBinOffsets.end() - 1);
+    mBinEdges.resize(mBinOffsets.back());
+    for (std::size_t i = 0; i < mEdges.size(); ++i) {
+        forEachBin(mEdges[i], [&](unsigned b) { mBinEdges[fill[b]++] = i; });
+    }
+
+    mStamps.assign(mNumOccluders, 0);
+    mStamp = 0;
+}
+
+const std::vector<OcclusionSweep::Occluder>& OcclusionSweep::query(const Position& point)
+{
+    mCandidates.clear();
+
+    const double px = point.x.value() - mOriginX;
+    const double py = point.y.value() - mOriginY;
+    const double distance = std::hypot(px, py);
+    if (distance < distanceTolerance) {
+        // degenerated line of sight without bearing
+        for (Occluder occluder = 0; occluder < mNumOccluders; ++occluder) {
+            mCandidates.push_back(occluder);
+        }
+        return mCandidates;
+    }
+
+    if (++mStamp == 0) {
+        std::fill(mStamps.begin(), mStamps.end(), 0);
+        mStamp = 1;
+    }
+
+    for (Occluder occluder : mUnbounded) {
+        if (mStamps[occluder] != mStamp) {
+            mStamps[occluder] = mStamp;
+            mCandidates.push_back(occluder);
+        }
+    }
+
+    const double angle = bearing(px, py);
+    const unsigned b = bin(angle);
+    for (std::size_t i = mBinOffsets[b]; i < mBinOffsets[b + 1]; ++i) {
+        const Edge& edge = mEdges[mBinEdges[i]];
+        if (mStamps[edge.occluder] == mStamp || edge.distance > distance + distanceTolerance) {
+            continue;
+        }
+
+        double delta = angle - edge.start;
+        if (delta < 0.0) {
+            delta += two_pi;
+        }
+        if (delta <= edge.span + angleTolerance || delta >= two_pi - angleTolerance) {
+            mStamps[edge.occluder] = mStamp;
+            mCandidates.push_back(edge.occluder);
+        }
+    }
+
+    return mCandidates;
+}
+
+double OcclusionSweep::bearing(double x, double y) const
+{
+    double angle = std::atan2(y, x);
+    if (angle < 0.0) {
+        angle += two_pi;
+    }
+    return angle < two_pi ? angle : 0.0;
+}
+
+unsigned OcclusionSweep::bin(double angle) const
+{
+    return std::min(static_cast<unsigned>(angle / mBinWidth), mNumBins - 1);
+}
+
+} // namespace artery
@@ -0,0 +1,83 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_ENVMOD_OCCLUSIONSWEEP_H_XH3LQV8D
+#define ARTERY_ENVMOD_OCCLUSIONSWEEP_H_XH3LQV8D
+
+#include "artery/utility/Geometry.h"
+#include <cstddef>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * OcclusionSweep is an angular index of occluder edges as seen from a sensor's origin.
+ *
+ * Each occluder edge covers an angular interval and has a minimum distance to the origin.
+ * A line of sight from the origin to a point can only be blocked by occluders having an edge
+ * whose interval contains the point's bearing and which is not farther away than the point itself.
+ * Queries yield those candidate occluders, exact intersection tests are left to the caller.
+ */
+class OcclusionSweep
+{
+public:
+    using Occluder = std::size_t;
+
+    /**
+     * @param origin sensor position, i.e. start of all lines of sight
+     * @param bins number of angular bins covering the full circle
+     */
+    OcclusionSweep(const Position& origin, unsigned bins = 720);
+
+    /**
+     * Add an occluder by its (open) outline polygon
+     * @param outline polygon points
+     * @return occluder index, counting up from zero in order of addition
+     */
+    Occluder add(const std::vector<Position>& outline);
+
+    /**
+     * Build angular index after all occluders have been added
+     */
+    void build();
+
+    /**
+     * Get occluders possibly blocking the line of sight from origin to point
+     * @param point end of line of sight
+     * @return candidate occluders (each at most once), valid until next query
+     */
+    const std::vector<Occluder>& query(const Position& point);
+
+private:
+    struct Edge
+    {
+        Occluder occluder;
+        double start; /*< begin of angular interval [0; 2pi) */
+        double span; /*< interval width [0; pi] */
+        double distance; /*< minimum distance to origin */
+    };
+
+    double bearing(double x, double y) const;
+    unsigned bin(double angle) const;
+    void addEdge(Occluder, const Position&, const Position&);
+
+    double mOriginX;
+    double mOriginY;
+    unsigned mNumBins;
+    double mBinWidth;
+    Occluder mNumOccluders = 0;
+    std::vector<Edge> mEdges;
+    std::vector<Occluder> mUnbounded; /*< occluders enclosing the origin */
+    std::vector<std::size_t> mBinOffsets;
+    std::vector<std::size_t> mBinEdges;
+    std::vector<unsigned> mStamps;
+    unsigned mStamp = 0;
+    std::vector<Occluder> mCandidates;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_ENVMOD_OCCLUSIONSWEEP_H_XH3LQV8D */
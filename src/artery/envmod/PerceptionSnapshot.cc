@@ -0,0 +1,64 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/envmod/PerceptionSnapshot.h"
+#include "artery/envmod/sensor/Sensor.h"
+#include <bitset>
+
+namespace artery
+{
+
+PerceptionSnapshot::PerceptionSnapshot(omnetpp::SimTime time, const std::vector<const Sensor*>& sensors) :
+    mTime(time)
+{
+    mSensorIds.reserve(sensors.size());
+    mSensorCategories.reserve(sensors.size());
+    for (const Sensor* sensor : sensors) {
+        mSensorIds.push_back(sensor->getId());
+        mSensorCategories.push_back(sensor->getSensorCategory());
+    }
+}
+
+void PerceptionSnapshot::add(const Entry& entry, const omnetpp::SimTime* last)
+{
+    mEntries.push_back(entry);
+    mLastSeen.insert(mLastSeen.end(), last, last + mSensorIds.size());
+}
+
+omnetpp::SimTime PerceptionSnapshot::lastSeen(std::size_t entry, std::size_t sensor) const
+{
+    return mLastSeen[entry * mSensorIds.size() + sensor];
+}
+
+PerceptionSnapshot::SensorMask PerceptionSnapshot::getSensorMask(const std::string& category) const
+{
+    SensorMask mask = 0;
+    for (std::size_t i = 0; i < mSensorIds.size(); ++i) {
+        if (mSensorCategories[i] == category) {
+            mask |= SensorMask(1) << i;
+        }
+    }
+    return mask;
+}
+
+std::size_t PerceptionSnapshot::countObjects(SensorMask mask) const
+{
+    std::size_t count = 0;
+    for (const Entry& entry : mEntries) {
+        count += (entry.sensors & mask) ? 1 : 0;
+    }
+    return count;
+}
+
+std::size_t PerceptionSnapshot::countTrackings(SensorMask mask) const
+{
+    std::size_t count = 0;
+    for (const Entry& entry : mEntries) {
+        count += std::bitset<64>(entry.sensors & mask).count();
+    }
+    return count;
+}
+
+} // namespace artery
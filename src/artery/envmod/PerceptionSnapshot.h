@@ -0,0 +1,88 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_ENVMOD_PERCEPTIONSNAPSHOT_H_K2TQ7BZE
+#define ARTERY_ENVMOD_PERCEPTIONSNAPSHOT_H_K2TQ7BZE
+
+#include <omnetpp/simtime.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace artery
+{
+
+class EnvironmentModelObject;
+class Sensor;
+
+/**
+ * Immutable copy of a LocalEnvironmentModel's trackings at one point in time
+ *
+ * Snapshots are shared by reference among all readers, e.g. services and the messages they generate.
+ * Because messages may outlive their sender, sensors are referred to by their IDs and categories only.
+ * Times of last detection are stored in a table with a row per entry and a column per sensor.
+ */
+class PerceptionSnapshot
+{
+public:
+    using SensorMask = std::uint64_t; /*< bit i refers to sensor i */
+
+    struct Entry
+    {
+        std::weak_ptr<EnvironmentModelObject> object;
+        int trackingId;
+        SensorMask sensors; /*< sensors currently tracking the object */
+    };
+
+    PerceptionSnapshot(omnetpp::SimTime time, const std::vector<const Sensor*>& sensors);
+
+    /**
+     * Add a tracked object, only used while creating the snapshot
+     * @param entry tracked object
+     * @param last time of last detection by each sensor (row of sensors().size() columns)
+     */
+    void add(const Entry& entry, const omnetpp::SimTime* last);
+
+    omnetpp::SimTime time() const { return mTime; }
+    const std::vector<int>& sensors() const { return mSensorIds; }
+    const std::vector<Entry>& entries() const { return mEntries; }
+    std::size_t size() const { return mEntries.size(); }
+
+    omnetpp::SimTime lastSeen(std::size_t entry, std::size_t sensor) const;
+
+    /**
+     * Get mask of all sensors belonging to a category
+     * @param category sensor category, e.g. "Radar" or "CA"
+     * @return sensor mask
+     */
+    SensorMask getSensorMask(const std::string& category) const;
+
+    /**
+     * Count entries tracked by any of the given sensors
+     * @param mask sensors of interest
+     * @return number of entries
+     */
+    std::size_t countObjects(SensorMask mask) const;
+
+    /**
+     * Count pairs of entry and sensor tracking it
+     * @param mask sensors of interest
+     * @return number of sensor trackings
+     */
+    std::size_t countTrackings(SensorMask mask) const;
+
+private:
+    omnetpp::SimTime mTime;
+    std::vector<int> mSensorIds;
+    std::vector<std::string> mSensorCategories;
+    std::vector<Entry> mEntries;
+    std::vector<omnetpp::SimTime> mLastSeen;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_ENVMOD_PERCEPTIONSNAPSHOT_H_K2TQ7BZE */
@@ -0,0 +1,150 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/envmod/PreselectionGrid.h"
+#include "artery/envmod/Geometry.h"
+#include "artery/envmod/sensor/SensorConfiguration.h"
+#include <boost/geometry.hpp>
+#include <omnetpp/cexception.h>
+#include <algorithm>
+#include <cmath>
+
+namespace artery
+{
+
+PreselectionGrid::PreselectionGrid(const Objects& objs, double cellSize) :
+    PreselectionMethod(objs), mCellSize(cellSize)
+{
+    if (mCellSize <= 0.0) {
+        throw omnetpp::cRuntimeError("grid cell size has to be positive");
+    }
+}
+
+void PreselectionGrid::update()
+{
+    if (mObjectCells.size() != mObjects.size()) {
+        // object database has been modified without notification, e.g. cleared
+        rebuild();
+        return;
+    }
+
+    for (const auto& object : mObjects) {
+        auto found = mObjectCells.find(object.get());
+        if (found == mObjectCells.end()) {
+            rebuild();
+            return;
+        } else if (!object->hasMoved()) {
+            continue;
+        }
+
+        const CellKey cell = getCellKey(object->getCentrePoint());
+        if (cell != found->second) {
+            removeFromCell(object.get(), found->second);
+            addToCell(object.get(), cell);
+            found->second = cell;
+        }
+    }
+}
+
+std::vector<PreselectionMethod::Handle> PreselectionGrid::select(const EnvironmentModelObject& ego, const SensorConfigRadar& config)
+{
+    const auto& cone = createSensorArc(config, ego);
+    if (!boost::geometry::is_valid(cone)) {
+        throw omnetpp::cRuntimeError("polygon of sensor cone is invalid");
+    }
+
+    // objects are binned by centre point, thus enlarge search area by largest object radius
+    const auto bbox = boost::geometry::return_envelope<geometry::Box>(cone);
+    const int minX = getCellIndex(bbox.min_corner().get<0>() - mMaxRadius);
+    const int minY = getCellIndex(bbox.min_corner().get<1>() - mMaxRadius);
+    const int maxX = getCellIndex(bbox.max_corner().get<0>() + mMaxRadius);
+    const int maxY = getCellIndex(bbox.max_corner().get<1>() + mMaxRadius);
+
+    std::vector<Handle> objectsInSensorCone;
+    for (int x = minX; x <= maxX; ++x) {
+        for (int y = minY; y <= maxY; ++y) {
+            auto found = mCells.find(getCellKey(x, y));
+            if (found == mCells.end()) {
+                continue;
+            }
+
+            for (const EnvironmentModelObject* object : found->second) {
+                if (object != &ego && boost::geometry::intersects(object->getOutline(), cone)) {
+                    objectsInSensorCone.push_back(object->getHandle());
+                }
+            }
+        }
+    }
+    return objectsInSensorCone;
+}
+
+void PreselectionGrid::insert(const EnvironmentModelObject& object)
+{
+    const CellKey cell = getCellKey(object.getCentrePoint());
+    auto insertion = mObjectCells.emplace(&object, cell);
+    if (insertion.second) {
+        addToCell(&object, cell);
+        mMaxRadius = std::max(mMaxRadius, object.getRadius().value());
+    }
+}
+
+void PreselectionGrid::remove(const EnvironmentModelObject& object)
+{
+    auto found = mObjectCells.find(&object);
+    if (found != mObjectCells.end()) {
+        removeFromCell(&object, found->second);
+        mObjectCells.erase(found);
+    }
+}
+
+void PreselectionGrid::rebuild()
+{
+    mCells.clear();
+    mObjectCells.clear();
+    mMaxRadius = 0.0;
+
+    for (const auto& object : mObjects) {
+        insert(*object);
+    }
+}
+
+void PreselectionGrid::addToCell(const EnvironmentModelObject* object, CellKey key)
+{
+    mCells[key].push_back(object);
+}
+
+void PreselectionGrid::removeFromCell(const EnvironmentModelObject* object, CellKey key)
+{
+    auto found = mCells.find(key);
+    if (found != mCells.end()) {
+        Cell& cell = found->second;
+        auto it = std::find(cell.begin(), cell.end(), object);
+        if (it != cell.end()) {
+            // order within a cell is irrelevant: swap with last element and pop it
+            *it = cell.back();
+            cell.pop_back();
+        }
+        if (cell.empty()) {
+            mCells.erase(found);
+        }
+    }
+}
+
+int PreselectionGrid::getCellIndex(double coord) const
+{
+    return static_cast<int>(std::floor(coord / mCellSize));
+}
+
+PreselectionGrid::CellKey PreselectionGrid::getCellKey(int x, int y) const
+{
+    return (static_cast<CellKey>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+}
+
+PreselectionGrid::CellKey PreselectionGrid::getCellKey(const Position& pos) const
+{
+    return getCellKey(getCellIndex(pos.x.value()), getCellIndex(pos.y.value()));
+}
+
+} // namespace artery
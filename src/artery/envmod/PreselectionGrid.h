@@ -0,0 +1,58 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_ENVMOD_PRESELECTIONGRID_H_R7KQ2MZC
+#define ARTERY_ENVMOD_PRESELECTIONGRID_H_R7KQ2MZC
+
+#include "artery/envmod/PreselectionMethod.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * Preselecting objects by a uniform spatial grid (hashed cells)
+ *
+ * Objects are binned by their centre point. The grid is maintained incrementally:
+ * only objects leaving their cell are moved between cells on update.
+ * Sensor cone queries visit only those cells overlapped by the cone's bounding box
+ * (enlarged by the largest object radius) and finally test object outlines against the cone.
+ */
+class PreselectionGrid : public PreselectionMethod
+{
+public:
+    /**
+     * @param objs object database
+     * @param cellSize edge length of grid cells in meters
+     */
+    PreselectionGrid(const Objects& objs, double cellSize);
+
+    void update() override;
+    std::vector<Handle> select(const EnvironmentModelObject& ego, const SensorConfigRadar&) override;
+    void insert(const EnvironmentModelObject&) override;
+    void remove(const EnvironmentModelObject&) override;
+
+private:
+    using CellKey = std::uint64_t;
+    using Cell = std::vector<const EnvironmentModelObject*>;
+
+    CellKey getCellKey(const Position&) const;
+    CellKey getCellKey(int x, int y) const;
+    int getCellIndex(double coord) const;
+    void addToCell(const EnvironmentModelObject*, CellKey);
+    void removeFromCell(const EnvironmentModelObject*, CellKey);
+    void rebuild();
+
+    double mCellSize;
+    double mMaxRadius = 0.0;
+    std::unordered_map<CellKey, Cell> mCells;
+    std::unordered_map<const EnvironmentModelObject*, CellKey> mObjectCells;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_ENVMOD_PRESELECTIONGRID_H_R7KQ2MZC */
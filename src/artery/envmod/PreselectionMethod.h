@@ -8,7 +8,6 @@
 #define ARTERY_ENVMOD_PRESELECTIONMETHOD_H_
 
 #include "artery/envmod/GlobalEnvironmentModel.h"
-#include <string>
 #include <vector>
 
 namespace artery
@@ -21,10 +20,31 @@ class PreselectionMethod
 {
 public:
     using Objects = GlobalEnvironmentModel::ObjectDB;
+    using Handle = EnvironmentModelObject::Handle;
 
     PreselectionMethod(const GlobalEnvironmentModel::ObjectDB& objs) : mObjects(objs) {}
+    virtual ~PreselectionMethod() = default;
     virtual void update() = 0;
-    virtual std::vector<std::string> select(const EnvironmentModelObject& ego, const SensorConfigRadar&) = 0;
+
+    /**
+     * Select objects possibly within the sensor cone
+     * @param ego object carrying the sensor (never selected itself)
+     * @param config sensor configuration
+     * @return handles of selected objects
+     */
+    virtual std::vector<Handle> select(const EnvironmentModelObject& ego, const SensorConfigRadar&) = 0;
+
+    /**
+     * Object has been added to the object database.
+     * Methods maintaining their structures incrementally can override this hook.
+     */
+    virtual void insert(const EnvironmentModelObject&) {}
+
+    /**
+     * Object is about to be removed from the object database.
+     * Object is still valid when this hook is called.
+     */
+    virtual void remove(const EnvironmentModelObject&) {}
 
 protected:
     const Objects& mObjects;
@@ -16,18 +16,18 @@ void PreselectionPolygon::update()
 {
 }
 
-std::vector<std::string> PreselectionPolygon::select(const EnvironmentModelObject& ego, const SensorConfigRadar& config)
+std::vector<PreselectionMethod::Handle> PreselectionPolygon::select(const EnvironmentModelObject& ego, const SensorConfigRadar& config)
 {
     const auto& sensorCone = createSensorArc(config, ego);
     if (!boost::geometry::is_valid(sensorCone)) {
         throw omnetpp::cRuntimeError("polygon of sensor cone is invalid");
     }
 
-    std::vector<std::string> objectsInSensorCone;
+    std::vector<Handle> objectsInSensorCone;
     for (const auto& object : mObjects) {
-        if (object->getExternalId() != ego.getExternalId()) {
+        if (object->getHandle() != ego.getHandle()) {
             if (boost::geometry::intersects(object->getOutline(), sensorCone)) {
-                objectsInSensorCone.push_back(object->getExternalId());
+                objectsInSensorCone.push_back(object->getHandle());
             }
         }
     }
@@ -21,7 +21,7 @@ public:
     using PreselectionMethod::PreselectionMethod;
 
     void update() override;
-    std::vector<std::string> select(const EnvironmentModelObject& ego, const SensorConfigRadar&) override;
+    std::vector<Handle> select(const EnvironmentModelObject& ego, const SensorConfigRadar&) override;
 };
 
 } // namespace artery
@@ -12,18 +12,94 @@
 namespace artery
 {
 
+namespace {
+
+geometry::Box getBox(const EnvironmentModelObject& object)
+{
+    return boost::geometry::return_envelope<geometry::Box>(object.getOutline());
+}
+
+} // namespace
+
 void PreselectionRtree::update()
 {
-    mRtree.clear();
+    if (mRtree.size() != mObjects.size()) {
+        // object database has been modified without notification, e.g. cleared
+        rebuild();
+        return;
+    }
 
+    mMoved.clear();
     for (const auto& object : mObjects) {
-        const auto& object_shape = object->getOutline();
-        auto box = boost::geometry::return_envelope<geometry::Box>(object_shape);
-        mRtree.insert(std::make_pair(box, object->getExternalId()));
+        if (!getEntry(object->getHandle()).indexed) {
+            rebuild();
+            return;
+        } else if (object->hasMoved()) {
+            mMoved.push_back(object.get());
+        }
+    }
+
+    // packing all boxes at once is cheaper than removing and re-inserting most of them
+    if (2 * mMoved.size() > mObjects.size()) {
+        rebuild();
+        return;
+    }
+
+    for (const EnvironmentModelObject* object : mMoved) {
+        Entry& entry = getEntry(object->getHandle());
+        mRtree.remove(std::make_pair(entry.box, object->getHandle()));
+        entry.box = getBox(*object);
+        mRtree.insert(std::make_pair(entry.box, object->getHandle()));
+    }
+}
+
+void PreselectionRtree::insert(const EnvironmentModelObject& object)
+{
+    Entry& entry = getEntry(object.getHandle());
+    if (!entry.indexed) {
+        entry.box = getBox(object);
+        entry.indexed = true;
+        mRtree.insert(std::make_pair(entry.box, object.getHandle()));
+    }
+}
+
+void PreselectionRtree::remove(const EnvironmentModelObject& object)
+{
+    Entry& entry = getEntry(object.getHandle());
+    if (entry.indexed) {
+        mRtree.remove(std::make_pair(entry.box, object.getHandle()));
+        entry.indexed = false;
+    }
+}
+
+void PreselectionRtree::rebuild()
+{
+    std::vector<rtree_value> values;
+    values.reserve(mObjects.size());
+    for (Entry& entry : mEntries) {
+        entry.indexed = false;
+    }
+
+    for (const auto& object : mObjects) {
+        Entry& entry = getEntry(object->getHandle());
+        entry.box = getBox(*object);
+        entry.indexed = true;
+        values.emplace_back(entry.box, object->getHandle());
+    }
+
+    // range constructor employs bulk loading, i.e. packing of R-tree nodes
+    mRtree = decltype(mRtree)(values.begin(), values.end());
+}
+
+PreselectionRtree::Entry& PreselectionRtree::getEntry(Handle handle)
+{
+    if (handle >= mEntries.size()) {
+        mEntries.resize(handle + 1);
     }
+    return mEntries[handle];
 }
 
-std::vector<std::string> PreselectionRtree::select(const EnvironmentModelObject& ego, const SensorConfigRadar& config)
+std::vector<PreselectionMethod::Handle> PreselectionRtree::select(const EnvironmentModelObject& ego, const SensorConfigRadar& config)
 {
     auto cone = createSensorArc(config, ego);
     if (!boost::geometry::is_valid(cone)) {
@@ -36,9 +112,9 @@ std::vector<std::string> PreselectionRtree::select(const EnvironmentModelObject&
     std::vector<rtree_value> query_result;
     mRtree.query(boost::geometry::index::intersects(cone_copy), std::back_inserter(query_result));
 
-    std::vector<std::string> objectsInSearchArea;
+    std::vector<Handle> objectsInSearchArea;
     for (const auto& intersection : query_result) {
-        if (intersection.second != ego.getExternalId()) {
+        if (intersection.second != ego.getHandle()) {
             objectsInSearchArea.push_back(intersection.second);
         }
     }
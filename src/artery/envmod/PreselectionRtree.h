@@ -9,21 +9,42 @@
 
 #include "artery/envmod/PreselectionMethod.h"
 #include <boost/geometry/index/rtree.hpp>
+#include <vector>
 
 namespace artery
 {
 
+/**
+ * Preselecting objects by an R-tree of their bounding boxes
+ *
+ * The R-tree is maintained incrementally: only boxes of moved objects are removed and re-inserted.
+ * If most objects have moved, the tree is rebuilt at once by bulk loading (packing) instead.
+ */
 class PreselectionRtree : public PreselectionMethod
 {
 public:
     using PreselectionMethod::PreselectionMethod;
 
     void update() override;
-    std::vector<std::string> select(const EnvironmentModelObject& ego, const SensorConfigRadar&) override;
+    std::vector<Handle> select(const EnvironmentModelObject& ego, const SensorConfigRadar&) override;
+    void insert(const EnvironmentModelObject&) override;
+    void remove(const EnvironmentModelObject&) override;
 
 private:
-    using rtree_value = std::pair<geometry::Box, std::string>;
+    using rtree_value = std::pair<geometry::Box, Handle>;
+
+    struct Entry
+    {
+        geometry::Box box; /*< box currently stored in R-tree */
+        bool indexed = false;
+    };
+
+    void rebuild();
+    Entry& getEntry(Handle);
+
     boost::geometry::index::rtree<rtree_value, boost::geometry::index::rstar<32>> mRtree;
+    std::vector<Entry> mEntries; /*< indexed by object handle */
+    std::vector<const EnvironmentModelObject*> mMoved;
 };
 
 } // namespace artery
@@ -0,0 +1,103 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/envmod/WorkerPool.h"
+#include <algorithm>
+
+namespace artery
+{
+
+WorkerPool::WorkerPool(unsigned threads) : mNextTask(0)
+{
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    // calling thread is one of the workers as well
+    for (unsigned i = 1; i < threads; ++i) {
+        mThreads.emplace_back(&WorkerPool::work, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShutdown = true;
+    }
+    mStart.notify_all();
+
+    for (auto& thread : mThreads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::run(std::size_t tasks, const Task& task)
+{
+    if (tasks == 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTask = &task;
+        mNumTasks = tasks;
+        mNextTask = 0;
+        mBusyWorkers = mThreads.size();
+        mError = nullptr;
+        ++mGeneration;
+    }
+    mStart.notify_all();
+
+    process();
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [this]() { return mBusyWorkers == 0; });
+    mTask = nullptr;
+
+    if (mError) {
+        std::exception_ptr error;
+        std::swap(error, mError);
+        std::rethrow_exception(error);
+    }
+}
+
+void WorkerPool::work()
+{
+    unsigned generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mStart.wait(lock, [&]() { return mShutdown || mGeneration != generation; });
+            if (mShutdown) {
+                break;
+            }
+            generation = mGeneration;
+        }
+
+        process();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (--mBusyWorkers == 0) {
+            mDone.notify_one();
+        }
+    }
+}
+
+void WorkerPool::process()
+{
+    for (std::size_t i = mNextTask++; i < mNumTasks; i = mNextTask++) {
+        try {
+            (*mTask)(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mError) {
+                mError = std::current_exception();
+            }
+        }
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,74 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_ENVMOD_WORKERPOOL_H_E2NWQ5TB
+#define ARTERY_ENVMOD_WORKERPOOL_H_E2NWQ5TB
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * WorkerPool executes a batch of independent tasks on a fixed set of threads.
+ *
+ * The calling thread participates in the batch and run() returns only after all tasks have been processed.
+ * Tasks must not access OMNeT++ facilities (simulation time, logging, signals) because those are not thread-safe.
+ */
+class WorkerPool
+{
+public:
+    using Task = std::function<void(std::size_t)>;
+
+    /**
+     * @param threads total number of threads including the calling thread, 0 selects hardware concurrency
+     */
+    explicit WorkerPool(unsigned threads);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * Run task for each index in [0; tasks)
+     *
+     * First exception thrown by any task is re-thrown after all tasks have finished.
+     * @param tasks number of tasks
+     * @param task callable invoked with task index
+     */
+    void run(std::size_t tasks, const Task& task);
+
+    /**
+     * Number of threads processing tasks, including the calling thread
+     */
+    unsigned size() const { return mThreads.size() + 1; }
+
+private:
+    void work();
+    void process();
+
+    std::vector<std::thread> mThreads;
+    std::mutex mMutex;
+    std::condition_variable mStart;
+    std::condition_variable mDone;
+    const Task* mTask = nullptr;
+    std::size_t mNumTasks = 0;
+    std::atomic<std::size_t> mNextTask;
+    unsigned mBusyWorkers = 0;
+    unsigned mGeneration = 0;
+    bool mShutdown = false;
+    std::exception_ptr mError;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_ENVMOD_WORKERPOOL_H_E2NWQ5TB */
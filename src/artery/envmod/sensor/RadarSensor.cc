@@ -40,12 +40,23 @@ void RadarSensor::initialize()
     mRadarConfig.fieldOfView.angle = par("fovAngle").doubleValue() * boost::units::degree::degrees;
     mRadarConfig.numSegments = par("numSegments");
     mRadarConfig.doLineOfSightCheck = par("doLineOfSightCheck");
+
+    mGlobalEnvironmentModel->registerDetection(mRadarConfig, [this]() {
+            return mLocalEnvironmentModel->isMeasurementDue(*this);
+        });
+}
+
+void RadarSensor::finish()
+{
+    // node managers call finish before deleting vehicles leaving the simulation
+    mGlobalEnvironmentModel->unregisterDetection(mRadarConfig);
+    BaseSensor::finish();
 }
 
 void RadarSensor::measurement()
 {
     Enter_Method("measurement");
-    auto objects = mGlobalEnvironmentModel->detectObjects(mRadarConfig);
+    auto objects = mGlobalEnvironmentModel->fetchDetection(mRadarConfig);
     mLocalEnvironmentModel->complementObjects(objects, *this);
     mLastDetection = std::move(objects);
 }
@@ -67,25 +78,42 @@ void RadarSensor::setVisualization(const SensorVisualizationConfig& config)
     if(config.linesOfSight && !mLinesOfSightFigure) {
         mLinesOfSightFigure = new cGroupFigure("lines of sight");
         mGroupFigure->addFigure(mLinesOfSightFigure);
+        mLinesOfSightPool.attach(mLinesOfSightFigure, [this](cLineFigure* line) {
+                line->setLineColor(mColor);
+                line->setLineStyle(cFigure::LINE_DASHED);
+            });
     } else if (!config.linesOfSight && mLinesOfSightFigure) {
         delete mLinesOfSightFigure->removeFromParent();
         mLinesOfSightFigure = nullptr;
+        mLinesOfSightPool.attach(nullptr);
     }
 
     if (config.obstaclesInSensorRange && !mObstaclesFigure) {
         mObstaclesFigure = new cGroupFigure("obstacles");
         mGroupFigure->addFigure(mObstaclesFigure);
+        mObstaclesPool.attach(mObstaclesFigure, [this](cPolygonFigure* polygon) {
+                polygon->setFilled(true);
+                polygon->setFillColor(mColor);
+                polygon->setLineColor(cFigure::BLUE);
+            });
     } else if (!config.obstaclesInSensorRange && mObstaclesFigure) {
         delete mObstaclesFigure->removeFromParent();
         mObstaclesFigure = nullptr;
+        mObstaclesPool.attach(nullptr);
     }
 
     if (config.objectsInSensorRange && !mObjectsFigure) {
         mObjectsFigure = new cGroupFigure("objects");
         mGroupFigure->addFigure(mObjectsFigure);
+        mObjectsPool.attach(mObjectsFigure, [this](cPolygonFigure* polygon) {
+                polygon->setFilled(true);
+                polygon->setFillColor(mColor);
+                polygon->setLineColor(cFigure::RED);
+            });
     } else if (!config.objectsInSensorRange && mObjectsFigure) {
         delete mObjectsFigure->removeFromParent();
         mObjectsFigure = nullptr;
+        mObjectsPool.attach(nullptr);
     }
 }
 
@@ -118,65 +146,37 @@ void RadarSensor::refreshDisplay() const
     }
 
     if (mSensorConeFigure) {
-        std::vector<cFigure::Point> points;
-        for (const auto& position : mLastDetection->sensorCone) {
-            points.push_back(cFigure::Point { position.x.value(), position.y.value() });
-        }
-        mSensorConeFigure->setPoints(points);
+        updateFigurePoints(*mSensorConeFigure, mLastDetection->sensorCone);
     }
 
+    // figures are re-used across refreshes, only changed geometry is updated
     if (mLinesOfSightFigure) {
-        // remove previous lines
-        while (mLinesOfSightFigure->getNumFigures() > 0) {
-            delete mLinesOfSightFigure->removeFigure(0);
-        }
-
         const Position& startPoint = mLastDetection->sensorCone.front();
-
+        mLinesOfSightPool.begin();
         for (const Position& endPoint : mLastDetection->visiblePoints) {
-            auto line = new cLineFigure();
-            line->setLineColor(mColor);
-            line->setLineStyle(cFigure::LINE_DASHED);
-            line->setStart(cFigure::Point { startPoint.x.value(), startPoint.y.value() });
-            line->setEnd(cFigure::Point { endPoint.x.value(), endPoint.y.value() });
-            mLinesOfSightFigure->addFigure(line);
+            updateFigureLine(*mLinesOfSightPool.acquire(), startPoint, endPoint);
         }
+        mLinesOfSightPool.end();
     }
 
     if (mObstaclesFigure) {
-        // remove previous obstacles
-        while (mObstaclesFigure->getNumFigures() > 0) {
-            delete mObstaclesFigure->removeFigure(0);
-        }
-
+        mObstaclesPool.begin();
         for (const auto& obstacle : mLastDetection->obstacles) {
-            auto polygon = new cPolygonFigure(obstacle->getObstacleId().c_str());
-            polygon->setFilled(true);
-            polygon->setFillColor(mColor);
-            polygon->setLineColor(cFigure::BLUE);
-            for (const auto& position : obstacle->getOutline()) {
-                polygon->addPoint(cFigure::Point { position.x.value(), position.y.value() });
-            }
-            mObstaclesFigure->addFigure(polygon);
+            auto polygon = mObstaclesPool.acquire();
+            polygon->setName(obstacle->getObstacleId().c_str());
+            updateFigurePoints(*polygon, obstacle->getOutline());
         }
+        mObstaclesPool.end();
     }
 
     if (mObjectsFigure) {
-        // remove previous objects
-        while (mObjectsFigure->getNumFigures() > 0) {
-            delete mObjectsFigure->removeFigure(0);
-        }
-
+        mObjectsPool.begin();
         for (const auto& object : mLastDetection->objects) {
-            auto polygon = new cPolygonFigure(object->getExternalId().c_str());
-            polygon->setFilled(true);
-            polygon->setFillColor(mColor);
-            polygon->setLineColor(cFigure::RED);
-            for (const auto& position : object->getOutline()) {
-                polygon->addPoint(cFigure::Point { position.x.value(), position.y.value() });
-            }
-            mObjectsFigure->addFigure(polygon);
+            auto polygon = mObjectsPool.acquire();
+            polygon->setName(object->getExternalId().c_str());
+            updateFigurePoints(*polygon, object->getOutline());
         }
+        mObjectsPool.end();
     }
 }
 
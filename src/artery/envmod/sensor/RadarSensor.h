@@ -10,6 +10,7 @@
 #include "artery/envmod/sensor/SensorConfiguration.h"
 #include "artery/envmod/sensor/SensorDetection.h"
 #include "artery/envmod/sensor/BaseSensor.h"
+#include "artery/utility/FigurePool.h"
 #include <omnetpp/ccanvas.h>
 #include <memory>
 
@@ -45,6 +46,7 @@ protected:
     };
 
     void initialize() override;
+    void finish() override;
     void refreshDisplay() const override;
 
     SensorConfigRadar mRadarConfig;
@@ -57,6 +59,9 @@ private:
     omnetpp::cGroupFigure* mLinesOfSightFigure;
     omnetpp::cGroupFigure* mObjectsFigure;
     omnetpp::cGroupFigure* mObstaclesFigure;
+    mutable FigurePool<omnetpp::cLineFigure> mLinesOfSightPool;
+    mutable FigurePool<omnetpp::cPolygonFigure> mObjectsPool;
+    mutable FigurePool<omnetpp::cPolygonFigure> mObstaclesPool;
 };
 
 } // namespace artery
@@ -23,14 +23,53 @@ void CollectivePerceptionMockMessage::setFovContainers(const std::vector<FovCont
     mFovContainers = std::make_shared<std::vector<FovContainer>>(fovs);
 }
 
+const std::vector<CollectivePerceptionMockMessage::ObjectContainer>& CollectivePerceptionMockMessage::getObjectContainers() const
+{
+    if (!mObjectContainers) {
+        auto objs = std::make_shared<std::vector<ObjectContainer>>();
+        objs->reserve(getNumObjectContainers());
+        const auto& sensors = mSnapshot->sensors();
+        for (std::size_t i = 0; i < mSnapshot->size(); ++i) {
+            const PerceptionSnapshot::Entry& entry = mSnapshot->entries()[i];
+            for (std::size_t sensor = 0; sensor < sensors.size(); ++sensor) {
+                if (entry.sensors & mSnapshotSensors & (PerceptionSnapshot::SensorMask(1) << sensor)) {
+                    ObjectContainer objectContainer;
+                    objectContainer.object = entry.object;
+                    objectContainer.objectId = entry.trackingId;
+                    objectContainer.sensorId = sensors[sensor];
+                    objectContainer.timeOfMeasurement = mSnapshot->lastSeen(i, sensor);
+                    objs->emplace_back(std::move(objectContainer));
+                }
+            }
+        }
+        mObjectContainers = std::move(objs);
+    }
+    return *mObjectContainers;
+}
+
 void CollectivePerceptionMockMessage::setObjectContainers(std::vector<ObjectContainer>&& objs)
 {
     mObjectContainers = std::make_shared<std::vector<ObjectContainer>>(std::move(objs));
+    mSnapshot.reset();
 }
 
 void CollectivePerceptionMockMessage::setObjectContainers(const std::vector<ObjectContainer>& objs)
 {
     mObjectContainers = std::make_shared<std::vector<ObjectContainer>>(objs);
+    mSnapshot.reset();
+}
+
+void CollectivePerceptionMockMessage::setObjectContainers(std::shared_ptr<const PerceptionSnapshot> snapshot,
+        PerceptionSnapshot::SensorMask sensors)
+{
+    mObjectContainers.reset();
+    mSnapshot = std::move(snapshot);
+    mSnapshotSensors = sensors;
+}
+
+std::size_t CollectivePerceptionMockMessage::getNumObjectContainers() const
+{
+    return mObjectContainers ? mObjectContainers->size() : mSnapshot->countTrackings(mSnapshotSensors);
 }
 
 omnetpp::cPacket* CollectivePerceptionMockMessage::dup() const
@@ -2,6 +2,7 @@
 #define ARTERY_COLLECTIVEPERCEPTIONMOCKMESSAGE_H_YUFJ5PSV
 
 #include "artery/envmod/LocalEnvironmentModel.h"
+#include "artery/envmod/PerceptionSnapshot.h"
 #include "artery/envmod/sensor/FieldOfView.h"
 #include "artery/envmod/sensor/SensorPosition.h"
 #include <omnetpp/cpacket.h>
@@ -37,10 +38,27 @@ public:
     void setFovContainers(std::vector<FovContainer>&& fovs);
     void setFovContainers(const std::vector<FovContainer>& fovs);
 
-    const std::vector<ObjectContainer>& getObjectContainers() const { return *mObjectContainers; }
+    /**
+     * Get object containers
+     *
+     * Containers referring to a perception snapshot are materialised on first access.
+     */
+    const std::vector<ObjectContainer>& getObjectContainers() const;
     void setObjectContainers(std::vector<ObjectContainer>&& objs);
     void setObjectContainers(const std::vector<ObjectContainer>& objs);
 
+    /**
+     * Refer to a perception snapshot instead of copying object containers
+     * @param snapshot shared perception snapshot
+     * @param sensors an object container is included for each tracking by one of these sensors
+     */
+    void setObjectContainers(std::shared_ptr<const PerceptionSnapshot> snapshot, PerceptionSnapshot::SensorMask sensors);
+
+    /**
+     * Get number of object containers without materialising them
+     */
+    std::size_t getNumObjectContainers() const;
+
     void setSourceStation(int id) { mSourceStation = id; }
     int getSourceStation() const { return mSourceStation; }
 
@@ -49,7 +67,9 @@ public:
 private:
     int mSourceStation = 0;
     std::shared_ptr<const std::vector<FovContainer>> mFovContainers;
-    std::shared_ptr<const std::vector<ObjectContainer>> mObjectContainers;
+    mutable std::shared_ptr<const std::vector<ObjectContainer>> mObjectContainers;
+    std::shared_ptr<const PerceptionSnapshot> mSnapshot;
+    PerceptionSnapshot::SensorMask mSnapshotSensors = 0;
 };
 
 } // namespace artery
@@ -60,15 +60,16 @@ void CollectivePerceptionMockService::initialize(int stage)
         }
         mHostId = getFacilities().get_const<Identity>().host->getId();
     } else if (stage == InitStages::Propagate) {
-        for (const Sensor* sensor : mEnvironmentModel->getSensors()) {
+        const auto& sensors = mEnvironmentModel->getSensors();
+        for (std::size_t i = 0; i < sensors.size(); ++i) {
             // skip any virtual sensors without field of view
-            if (auto fov = sensor->getFieldOfView()) {
+            if (auto fov = sensors[i]->getFieldOfView()) {
                 CollectivePerceptionMockMessage::FovContainer fovContainer;
-                fovContainer.sensorId = sensor->getId();
-                fovContainer.position = sensor->position();
+                fovContainer.sensorId = sensors[i]->getId();
+                fovContainer.position = sensors[i]->position();
                 fovContainer.fov = *fov;
                 mFovContainers.emplace_back(std::move(fovContainer));
-                mSensors.insert(sensor);
+                mSensors |= PerceptionSnapshot::SensorMask(1) << i;
             }
         }
     }
@@ -131,28 +132,9 @@ void CollectivePerceptionMockService::generatePacket()
         mFovLast = omnetpp::simTime();
     }
 
-    std::vector<CollectivePerceptionMockMessage::ObjectContainer> objectContainers;
-    using TrackedObject = LocalEnvironmentModel::TrackedObject;
-    for (const TrackedObject& object : mEnvironmentModel->allObjects()) {
-        const LocalEnvironmentModel::Tracking& tracking = object.second;
-        if (tracking.expired()) {
-            // skip objects with lost tracking
-            continue;
-        }
-
-        for (const auto& sensor : tracking.sensors()) {
-            if (mSensors.find(sensor.first) != mSensors.end()) {
-                CollectivePerceptionMockMessage::ObjectContainer objectContainer;
-                objectContainer.object = object.first;
-                objectContainer.objectId = tracking.id();
-                objectContainer.sensorId = sensor.first->getId();
-                objectContainer.timeOfMeasurement = sensor.second.last();
-                objectContainers.emplace_back(std::move(objectContainer));
-            }
-        }
-    }
-    packet->addByteLength(mLengthObjectContainer * objectContainers.size());
-    packet->setObjectContainers(std::move(objectContainers));
+    // object containers refer to the shared snapshot, objects with lost tracking have no sensors left
+    packet->setObjectContainers(mEnvironmentModel->getSnapshot(), mSensors);
+    packet->addByteLength(mLengthObjectContainer * packet->getNumObjectContainers());
     packet->setSourceStation(mHostId);
 
     emit(cpmSentSignal, packet);
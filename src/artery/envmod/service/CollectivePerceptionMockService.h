@@ -10,7 +10,6 @@
 #include "artery/envmod/service/CollectivePerceptionMockMessage.h"
 #include "artery/application/ItsG5Service.h"
 #include "artery/networking/PositionProvider.h"
-#include <unordered_set>
 #include <vector>
 
 namespace artery
@@ -41,7 +40,7 @@ class CollectivePerceptionMockService : public ItsG5Service
         omnetpp::SimTime mFovInterval = omnetpp::SimTime::ZERO;
         omnetpp::SimTime mFovLast = omnetpp::SimTime::ZERO;
         std::vector<CollectivePerceptionMockMessage::FovContainer> mFovContainers;
-        std::unordered_set<const Sensor*> mSensors;
+        PerceptionSnapshot::SensorMask mSensors = 0; /*< sensors with field of view */
         unsigned mDccProfile = 0;
         unsigned mLengthHeader = 0;
         unsigned mLengthFovContainer = 0;
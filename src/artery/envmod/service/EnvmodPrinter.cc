@@ -26,18 +26,19 @@ void EnvmodPrinter::initialize()
 void EnvmodPrinter::trigger()
 {
     Enter_Method("trigger");
-    auto& allObjects = mLocalEnvironmentModel->allObjects();
-    printSensorObjectList("Radar Sensor Object List", filterBySensorCategory(allObjects, "Radar"));
-    printSensorObjectList("CAM Sensor Object List", filterBySensorCategory(allObjects, "CA"));
+    auto snapshot = mLocalEnvironmentModel->getSnapshot();
+    printSensorObjectList("Radar Sensor Object List", *snapshot, snapshot->getSensorMask("Radar"));
+    printSensorObjectList("CAM Sensor Object List", *snapshot, snapshot->getSensorMask("CA"));
 }
 
-void EnvmodPrinter::printSensorObjectList(const std::string& title, const TrackedObjectsFilterRange& objs)
+void EnvmodPrinter::printSensorObjectList(const std::string& title, const PerceptionSnapshot& snapshot, PerceptionSnapshot::SensorMask sensors)
 {
-    EV_DETAIL << mEgoId << "--- " << title << " (" << boost::size(objs) << " objects) ---" << std::endl;
+    EV_DETAIL << mEgoId << "--- " << title << " (" << snapshot.countObjects(sensors) << " objects) ---" << std::endl;
 
-    for (const auto& obj : objs)
+    for (const auto& entry : snapshot.entries())
     {
-        std::weak_ptr<EnvironmentModelObject> obj_ptr = obj.first;
+        if (!(entry.sensors & sensors)) continue;
+        std::weak_ptr<EnvironmentModelObject> obj_ptr = entry.object;
         if (obj_ptr.expired()) continue; /*< objects remain in tracking briefly after leaving simulation */
         const auto& vd = obj_ptr.lock()->getVehicleData();
         EV_DETAIL
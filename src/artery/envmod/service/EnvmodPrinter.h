@@ -9,6 +9,7 @@
 
 #include "artery/application/ItsG5Service.h"
 #include "artery/envmod/LocalEnvironmentModel.h"
+#include "artery/envmod/PerceptionSnapshot.h"
 #include <string>
 
 namespace artery
@@ -25,7 +26,7 @@ class EnvmodPrinter : public ItsG5Service
         void trigger() override;
 
     private:
-        void printSensorObjectList(const std::string& title, const TrackedObjectsFilterRange&);
+        void printSensorObjectList(const std::string& title, const PerceptionSnapshot&, PerceptionSnapshot::SensorMask);
 
         LocalEnvironmentModel* mLocalEnvironmentModel;
         std::string mEgoId;
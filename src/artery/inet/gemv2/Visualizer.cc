@@ -1,6 +1,7 @@
 #include "artery/inet/gemv2/Visualizer.h"
 #include "artery/inet/gemv2/ObstacleIndex.h"
 #include "artery/inet/gemv2/VehicleIndex.h"
+#include <array>
 
 namespace artery
 {
@@ -19,6 +20,9 @@ void Visualizer::initialize(int stage)
         canvas->addFigure(mVehicleGroup);
         canvas->addFigure(mRaysGroup);
         canvas->setBackgroundColor(omnetpp::cFigure::GREY);
+
+        mRayPolylines.attach(mRaysGroup);
+        mRayLines.attach(mRaysGroup);
     }
 }
 
@@ -39,23 +43,22 @@ omnetpp::cGroupFigure* Visualizer::getObstacleGroup(const omnetpp::cModule* modu
 
 void Visualizer::drawObstacles(const ObstacleIndex* index)
 {
-    omnetpp::cGroupFigure* group = getObstacleGroup(index);
-    for (int i = group->getNumFigures() - 1; i >= 0; --i)
-    {
-        delete group->removeFigure(i);
+    FigurePool<omnetpp::cPolygonFigure>& polygons = mObstaclePolygons[index->getId()];
+    if (!polygons.group()) {
+        const omnetpp::cFigure::Color color = index->getColor();
+        polygons.attach(getObstacleGroup(index), [color](omnetpp::cPolygonFigure* polygon) {
+                polygon->setLineColor(color);
+            });
     }
 
+    // re-use polygons of previous drawing, e.g. after TraCI reconnect
     auto obstacles = index->getObstacles();
+    polygons.begin();
     for (auto& obstacle : obstacles)
     {
-        auto polygon = new omnetpp::cPolygonFigure();
-        polygon->setLineColor(index->getColor());
-        for (const Position& pos : obstacle.getOutline())
-        {
-            polygon->addPoint(omnetpp::cFigure::Point { pos.x.value(), pos.y.value() });
-        }
-        group->addFigure(polygon);
+        updateFigurePoints(*polygons.acquire(), obstacle.getOutline());
     }
+    polygons.end();
 }
 
 void Visualizer::drawVehicles(const VehicleIndex* index)
@@ -89,20 +92,13 @@ void Visualizer::drawVehicles(const VehicleIndex* index)
             polygon->setLineColor(omnetpp::cFigure::BLUE);
         } else {
             // update existing polygon
-            omnetpp::cPolygonFigure* polygon = found->second;
-            auto& outline = name_vehicle.second.getOutline();
-            for (int i = 0; i < polygon->getNumPoints(); ++i)
-            {
-                polygon->setPoint(i, omnetpp::cFigure::Point { outline[i].x.value(), outline[i].y.value() });
-            }
+            updateFigurePoints(*found->second, name_vehicle.second.getOutline());
         }
     }
 
-    // remove all previous rays
-    for (int i = mRaysGroup->getNumFigures() - 1; i >= 0; --i)
-    {
-        delete mRaysGroup->removeFigure(i);
-    }
+    // hide all previous rays, their figures are re-used for upcoming rays
+    mRayPolylines.clear();
+    mRayLines.clear();
 }
 
 void Visualizer::drawReflectionRays(const Position& tx, const Position& rx,
@@ -129,36 +125,26 @@ void Visualizer::drawFoliageRay(const Position& tx, const Position& rx, const st
     const Position* start = &tx;
     for (const Position& point : foliage)
     {
-        auto figure = new omnetpp::cLineFigure();
-        mRaysGroup->addFigure(figure);
+        auto figure = mRayLines.acquire();
         figure->setLineColor(isOutside ? outside : inside);
-        figure->setStart(omnetpp::cFigure::Point { start->x.value(), start->y.value() });
-        figure->setEnd(omnetpp::cFigure::Point { point.x.value(), point.y.value() });
+        updateFigureLine(*figure, *start, point);
         start = &point;
         isOutside = !isOutside;
     }
 
-    auto figure = new omnetpp::cLineFigure();
-    mRaysGroup->addFigure(figure);
+    auto figure = mRayLines.acquire();
     figure->setLineColor(outside);
-    figure->setStart(omnetpp::cFigure::Point { start->x.value(), start->y.value() });
-    figure->setEnd(omnetpp::cFigure::Point { rx.x.value(), rx.y.value() });
+    updateFigureLine(*figure, *start, rx);
 }
 
 void Visualizer::drawRays(const Position& tx, const Position& rx,
         const std::vector<Position>& points, omnetpp::cFigure::Color c) const
 {
-    const omnetpp::cFigure::Point begin { tx.x.value(), tx.y.value() };
-    const omnetpp::cFigure::Point end { rx.x.value(), rx.y.value() };
-
     for (auto& point : points)
     {
-        auto figure = new omnetpp::cPolylineFigure();
-        mRaysGroup->addFigure(figure);
+        auto figure = mRayPolylines.acquire();
         figure->setLineColor(c);
-        figure->addPoint(begin);
-        figure->addPoint(omnetpp::cFigure::Point { point.x.value(), point.y.value() });
-        figure->addPoint(end);
+        updateFigurePoints(*figure, std::array<Position, 3> {{ tx, point, rx }});
     }
 }
 
@@ -1,6 +1,7 @@
 #ifndef ARTERY_GEMV2_VISUALIZER_H_U4LMLGVJ
 #define ARTERY_GEMV2_VISUALIZER_H_U4LMLGVJ
 
+#include "artery/utility/FigurePool.h"
 #include "artery/utility/Geometry.h"
 #include <omnetpp/ccanvas.h>
 #include <omnetpp/csimplemodule.h>
@@ -37,6 +38,9 @@ private:
     omnetpp::cGroupFigure* mRaysGroup;
     std::unordered_map<std::string, omnetpp::cPolygonFigure*> mVehiclePolygons;
     std::unordered_map<int, omnetpp::cGroupFigure*> mObstacleGroups;
+    std::unordered_map<int, FigurePool<omnetpp::cPolygonFigure>> mObstaclePolygons;
+    mutable FigurePool<omnetpp::cPolylineFigure> mRayPolylines;
+    FigurePool<omnetpp::cLineFigure> mRayLines;
 };
 
 } // namespace gemv2
@@ -152,29 +152,25 @@ ConditionResult TtcCondition::testCondition(const Vehicle& car)
 
 void TtcCondition::drawCondition(omnetpp::cCanvas* canvas)
 {
-    for(auto& fig : mFigures) {
-        canvas->removeFigure(fig);
-        delete fig;
+    if (!mFigures.group()) {
+        auto group = new omnetpp::cGroupFigure("time to collision");
+        canvas->addFigure(group);
+        mFigures.attach(group);
     }
-    mFigures.clear();
 
-    drawPath(mEgoRoute, canvas);
+    // polygons of previous paths are re-used
+    mFigures.begin();
+    drawPath(mEgoRoute);
     for(auto& p : mOthersRoute) {
-        drawPath(p, canvas);
+        drawPath(p);
     }
+    mFigures.end();
 }
 
-void TtcCondition::drawPath(const Route& route, omnetpp::cCanvas* canvas)
+void TtcCondition::drawPath(const Route& route)
 {
     for(const auto &shape : route) {
-
-        omnetpp::cPolygonFigure* fig = new omnetpp::cPolygonFigure();
-        for(const auto& point : shape) {
-            fig->addPoint(omnetpp::cFigure::Point(point.x.value(), point.y.value()));
-        }
-
-        canvas->addFigure(fig);
-        mFigures.push_back(fig);
+        updateFigurePoints(*mFigures.acquire(), shape);
     }
 }
 
@@ -3,6 +3,7 @@
 
 #include "artery/storyboard/CarSetCondition.h"
 #include "artery/storyboard/Condition.h"
+#include "artery/utility/FigurePool.h"
 #include "artery/utility/Geometry.h"
 #include <omnetpp/ccanvas.h>
 #include <vector>
@@ -105,10 +106,10 @@ private:
     Route mEgoRoute;
     std::vector<Route> mOthersRoute;
 
-    std::list<omnetpp::cFigure*> mFigures;
+    FigurePool<omnetpp::cPolygonFigure> mFigures;
 
     void drawCondition(omnetpp::cCanvas*) override;
-    void drawPath(const Route& route, omnetpp::cCanvas* canvas);
+    void drawPath(const Route& route);
 };
 
 } // namespace artery
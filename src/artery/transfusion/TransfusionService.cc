@@ -15,6 +15,7 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/.
 // 
 
+#include "artery/application/SharedByteBuffer.h"
 #include "artery/transfusion/TransfusionService.h"
 #include "artery/utility/AsioScheduler.h"
 #include "TransfusionMsg.pb.h"
@@ -118,7 +119,10 @@ void TransfusionService::processMessage(const Transfusion::TransfusionMsg& msg)
     request.gn.communication_profile = geonet::CommunicationProfile::ITS_G5;
 
     std::unique_ptr<geonet::DownPacket> payload { new geonet::DownPacket };
-    payload->layer(OsiLayer::Application) = std::move(msg.payload());
+    std::unique_ptr<convertible::byte_buffer> buffer {
+        new SharedByteBuffer(ByteBuffer { msg.payload().begin(), msg.payload().end() })
+    };
+    payload->layer(OsiLayer::Application) = std::move(buffer);
     this->request(request, std::move(payload));
 }
 
@@ -0,0 +1,159 @@
+#ifndef ARTERY_FIGUREPOOL_H_C7NW2RQE
+#define ARTERY_FIGUREPOOL_H_C7NW2RQE
+
+#include "artery/utility/Geometry.h"
+#include <omnetpp/ccanvas.h>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * FigurePool keeps figures of a group for re-use across display refreshes
+ *
+ * Figures are acquired one by one between begin() and end() of each refresh.
+ * Figures not acquired during a refresh are hidden instead of being deleted.
+ * The pool does not own its figures, they are owned by the group figure.
+ */
+template<typename T>
+class FigurePool
+{
+public:
+    using Setup = std::function<void(T*)>;
+
+    FigurePool() = default;
+    FigurePool(const FigurePool&) = delete;
+    FigurePool& operator=(const FigurePool&) = delete;
+
+    /**
+     * Attach pool to a group figure
+     *
+     * Previously pooled figures are forgotten, e.g. because their group has been deleted.
+     * @param group parent of pooled figures (or nullptr)
+     * @param setup invoked once for each created figure, e.g. to set colors
+     */
+    void attach(omnetpp::cGroupFigure* group, Setup setup = nullptr)
+    {
+        mGroup = group;
+        mSetup = std::move(setup);
+        mFigures.clear();
+        mUsed = 0;
+    }
+
+    omnetpp::cGroupFigure* group() const { return mGroup; }
+
+    /**
+     * Start a refresh
+     */
+    void begin() { mUsed = 0; }
+
+    /**
+     * Get next figure of this refresh, created only if no figure is available for re-use
+     * @return visible figure
+     */
+    T* acquire()
+    {
+        T* figure = nullptr;
+        if (mUsed < mFigures.size()) {
+            figure = mFigures[mUsed];
+            if (!figure->isVisible()) {
+                figure->setVisible(true);
+            }
+        } else {
+            figure = new T();
+            if (mSetup) {
+                mSetup(figure);
+            }
+            mGroup->addFigure(figure);
+            mFigures.push_back(figure);
+        }
+        ++mUsed;
+        return figure;
+    }
+
+    /**
+     * Finish a refresh: hide figures not acquired since begin()
+     */
+    void end()
+    {
+        for (std::size_t i = mUsed; i < mFigures.size(); ++i) {
+            if (mFigures[i]->isVisible()) {
+                mFigures[i]->setVisible(false);
+            }
+        }
+    }
+
+    /**
+     * Hide all figures at once
+     */
+    void clear()
+    {
+        begin();
+        end();
+    }
+
+private:
+    omnetpp::cGroupFigure* mGroup = nullptr;
+    Setup mSetup;
+    std::vector<T*> mFigures;
+    std::size_t mUsed = 0;
+};
+
+inline omnetpp::cFigure::Point toFigurePoint(const Position& pos)
+{
+    return omnetpp::cFigure::Point { pos.x.value(), pos.y.value() };
+}
+
+/**
+ * Update points of a polygon or polyline figure, unchanged points are left untouched
+ * @param figure polygon or polyline figure
+ * @param points new points
+ * @return true if any point has changed
+ */
+template<typename T, typename POINTS>
+bool updateFigurePoints(T& figure, const POINTS& points)
+{
+    bool changed = false;
+    if (static_cast<std::size_t>(figure.getNumPoints()) != points.size()) {
+        std::vector<omnetpp::cFigure::Point> figurePoints;
+        figurePoints.reserve(points.size());
+        for (const auto& point : points) {
+            figurePoints.push_back(toFigurePoint(point));
+        }
+        figure.setPoints(figurePoints);
+        changed = true;
+    } else {
+        int i = 0;
+        for (const auto& point : points) {
+            const omnetpp::cFigure::Point figurePoint = toFigurePoint(point);
+            const omnetpp::cFigure::Point& current = figure.getPoint(i);
+            if (current.x != figurePoint.x || current.y != figurePoint.y) {
+                figure.setPoint(i, figurePoint);
+                changed = true;
+            }
+            ++i;
+        }
+    }
+    return changed;
+}
+
+/**
+ * Update end points of a line figure if they have changed
+ */
+inline void updateFigureLine(omnetpp::cLineFigure& figure, const Position& start, const Position& end)
+{
+    const omnetpp::cFigure::Point startPoint = toFigurePoint(start);
+    const omnetpp::cFigure::Point endPoint = toFigurePoint(end);
+    if (figure.getStart().x != startPoint.x || figure.getStart().y != startPoint.y) {
+        figure.setStart(startPoint);
+    }
+    if (figure.getEnd().x != endPoint.x || figure.getEnd().y != endPoint.y) {
+        figure.setEnd(endPoint);
+    }
+}
+
+} // namespace artery
+
+#endif /* ARTERY_FIGUREPOOL_H_C7NW2RQE */